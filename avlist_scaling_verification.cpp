@@ -0,0 +1 @@
+#include <meta/detail/avlist_scaling_verification.hpp>
@@ -0,0 +1,141 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Size benchmark: a table of META_BENCHMARK_SIZE values used from two translation units.
+//
+// The file is compiled twice into one executable, once with META_BENCHMARK_UNIT=1. Both units take the table from the
+// same list, the second unit also as the projection of a type list, and hand its address out. With
+// value_list::to_array / type_list::to_array all three are one object: the table is an inline variable, every unit
+// emits it into the same comdat group and the linker keeps one. With META_BENCHMARK_NAIVE defined every unit writes
+// its own pack expansion into an array of its own, and .rodata holds one copy per unit. The program returns non-zero
+// if the folded variant does not share the table.
+//
+// GCC 12, -O0, 1000 values of type int (.rodata of the executable, size -A):
+//     naive                  to_array
+//     8.2kB, 2 tables        4.1kB, 1 table
+//
+// Measure with
+//     size -A (.rodata), nm -C (one meta::common::detail::value_array<...>::values)
+//
+
+#include <meta/vlist.hpp>
+#include <meta/tlist.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <type_traits>
+#include <utility>
+
+#ifndef META_BENCHMARK_SIZE
+#define META_BENCHMARK_SIZE 1000
+#endif
+
+#ifndef META_BENCHMARK_UNIT
+#define META_BENCHMARK_UNIT 0
+#endif
+
+namespace meta::benchmark::rodata {
+
+    static constexpr size_t table_size = META_BENCHMARK_SIZE;
+
+    template<typename T, T... Vs>
+    struct custom_vlist {};
+
+    template<int Id>
+    struct opcode
+    {
+        static constexpr int id = Id;
+    };
+
+    template<typename Opcode>
+    struct opcode_id : std::integral_constant<int, Opcode::id> {};
+
+    template<typename Indices>
+    struct make_lists;
+
+    template<size_t... Is>
+    struct make_lists<std::index_sequence<Is...>>
+    {
+        using values        = vlist<int, static_cast<int>(Is * Is % 7919)...>;
+        using custom_values = custom_vlist<int, static_cast<int>(Is * Is % 7919)...>;
+        using opcodes       = tlist<opcode<static_cast<int>(Is * Is % 7919)>...>;
+    };
+
+    using lists = make_lists<std::make_index_sequence<table_size>>;
+
+#ifdef META_BENCHMARK_NAIVE
+    // the usual hand-written expansion, local to the translation unit
+    namespace {
+        template<typename Indices>
+        struct naive_table;
+
+        template<size_t... Is>
+        struct naive_table<std::index_sequence<Is...>>
+        {
+            static constexpr std::array<int, sizeof...(Is)> values = { static_cast<int>(Is * Is % 7919)... };
+        };
+
+        using naive = naive_table<std::make_index_sequence<table_size>>;
+    }
+#endif
+
+    struct table_view
+    {
+        const int* data;
+        size_t size;
+    };
+
+#if META_BENCHMARK_UNIT == 0
+    table_view values_table()
+#else
+    table_view custom_values_table()
+#endif
+    {
+#ifdef META_BENCHMARK_NAIVE
+        return { naive::values.data(), naive::values.size() };
+#elif META_BENCHMARK_UNIT == 0
+        return { value_list::to_array<lists::values>.data(), table_size };
+#else
+        return { value_list::to_array<lists::custom_values>.data(), table_size };
+#endif
+    }
+
+#if META_BENCHMARK_UNIT == 1
+    table_view opcodes_table()
+    {
+#ifdef META_BENCHMARK_NAIVE
+        return { naive::values.data(), naive::values.size() };
+#else
+        return { type_list::to_array<lists::opcodes, opcode_id>.data(), table_size };
+#endif
+    }
+#endif
+
+}
+
+#if META_BENCHMARK_UNIT == 0
+
+namespace meta::benchmark::rodata {
+    table_view custom_values_table();
+    table_view opcodes_table();
+}
+
+int main()
+{
+    using namespace meta::benchmark::rodata;
+
+    const bool shared =
+        values_table().data == custom_values_table().data && values_table().data == opcodes_table().data;
+    std::printf("%zu values, %s\n", values_table().size, shared ? "one table" : "one table per translation unit");
+
+#ifdef META_BENCHMARK_NAIVE
+    return 0;
+#else
+    return shared ? 0 : 1;
+#endif
+}
+
+#endif
@@ -0,0 +1,112 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Compile-time benchmark: traverse a generated tree with tree_verification.hpp style contexts.
+//
+// Every advance step of a traversal names a new path stack tlist, and every ADL lookup on the resulting iterator
+// instantiates it. The cost of a tlist instantiation is therefore multiplied by the number of visited nodes.
+// With META_BENCHMARK_INDEXED defined the trees are traversed through contexts::indexed, whose path stacks are the
+// root plus a list of child indices.
+//
+// GCC 12, -O0, fan_out 4 (time, peak memory, length of the pretty name of a leaf iterator in the middle):
+//     depth     path stack                   indexed
+//     3         1.17s  197MB  1477 chars     0.82s  154MB  1166 chars
+//     4         13.2s  651MB  5489 chars     7.40s  434MB  4141 chars
+//
+// Object file at -O0 (size, number of symbols, their total mangled length, nm):
+//     depth     path stack                   indexed
+//     3         1.83MB  1733 symbols  1.78MB   1.11MB  1393 symbols  1.07MB
+//     4         26.9MB  6917 symbols  26.7MB   15.6MB  5553 symbols  15.5MB
+// The object file is almost all symbol names: 3.9kB per symbol on average with path stacks, 2.8kB indexed, at depth 4.
+// The longest names are those of the queries on the whole tree, the same for both.
+//
+// Measure with
+//     GCC:   -ftime-report (TOTAL line: time and GGC memory), -fdump-lang-class (grep -c "^Class meta::tlist<")
+//     nm:    nm x.o | wc -l, nm x.o | awk '{ print $NF }' | wc -c
+//     Clang: -ftime-trace
+//
+
+#include <meta/tree.hpp>
+#include <meta/algorithm.hpp>
+#include <meta/util.hpp>
+#include <utility>
+
+namespace meta::benchmark::tree_instantiation {
+
+    static constexpr size_t fan_out = 4;
+    static constexpr size_t depth   = 3;
+
+    template<size_t Id>
+    struct leaf
+    {
+        static constexpr size_t num_children = 0;
+    };
+
+    template<typename... Children>
+    struct inner
+    {
+        template<size_t Index>
+        using get_child = type_list::get<inner, Index>;
+
+        static constexpr size_t num_children = sizeof...(Children);
+    };
+
+    // full fan_out-ary tree of the given depth, leaves are numbered left to right
+    template<template<typename...> typename Node, size_t Depth, size_t First = 0, typename Indices = std::make_index_sequence<fan_out>>
+    struct make_tree;
+
+    template<template<typename...> typename Node, size_t Depth, size_t First, size_t... Is>
+    struct make_tree<Node, Depth, First, std::index_sequence<Is...>>
+    {
+        static constexpr size_t leaves = fan_out * make_tree<Node, Depth - 1>::leaves;
+
+        using type = Node<typename make_tree<Node, Depth - 1, First + Is * (leaves / fan_out)>::type...>;
+    };
+
+    template<template<typename...> typename Node, size_t First, size_t... Is>
+    struct make_tree<Node, 0, First, std::index_sequence<Is...>>
+    {
+        static constexpr size_t leaves = 1;
+
+        using type = leaf<First>;
+    };
+
+    static constexpr size_t num_leaves = make_tree<inner, depth>::leaves;
+
+    using tlist_tree     = typename make_tree<tlist, depth>::type;
+    using intrusive_tree = typename make_tree<inner, depth>::type;
+
+#ifdef META_BENCHMARK_INDEXED
+    using tlist_context     = contexts::indexed<contexts::tlist>;
+    using intrusive_context = contexts::indexed<contexts::intrusive>;
+#else
+    using tlist_context     = contexts::tlist;
+    using intrusive_context = contexts::intrusive;
+#endif
+
+    static_assert(
+        type_list::size<accumulate_t<range_lr<tlist_tree, tlist_context>>> == num_leaves
+    );
+
+    static_assert(
+        are_same_v<
+            type_list::back<accumulate_t<range_nlr<tlist_tree, tlist_context>>>,
+            leaf<num_leaves - 1>
+        >
+    );
+
+    static_assert(
+        type_list::size<accumulate_t<range_lr<intrusive_tree, intrusive_context>>> == num_leaves
+    );
+
+    static_assert(
+        are_same_v<
+            type_list::back<accumulate_t<range_nlr<intrusive_tree, intrusive_context>>>,
+            leaf<num_leaves - 1>
+        >
+    );
+
+}
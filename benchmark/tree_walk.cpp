@@ -0,0 +1,182 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Runtime benchmark: walk a type tree at runtime, once through the records of flatten_tree and once through a recursive
+// visitor that the compiler unrolls into straight code, one body per node.
+//
+// The walks add up a runtime value per node. The pruned walks skip the subtree below every node whose value is a
+// multiple of 8, the table walk by jumping to subtree_end. The values are random and change between repetitions.
+//
+// GCC 12, -O2, fan_out 4, depth 5 (1365 nodes), time per walk:
+//     walk      table      recursive
+//     full      0.32us     0.22us
+//     pruned    0.30us     0.22us
+// The unrolled walks are faster at this size, but every one of them is code of its own: 12kB for the full walk and
+// 23kB for the pruned one (nm -S), against 112 bytes for both loops. The records take 21kB of .rodata, shared by any
+// number of walks: 16 bytes each with 16 bit indices. With size_t indices they took 48 bytes and the walks 0.33us
+// and 0.34us.
+//
+// Run meta.benchmark.tree_walk, it prints the table above.
+//
+
+#include <meta/tree_table.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace meta::benchmark::tree_walk {
+
+    static constexpr size_t fan_out = 4;
+    static constexpr size_t depth   = 5;
+
+    // nodes are numbered in preorder
+    template<size_t Id, typename... Children>
+    struct node
+    {
+        static constexpr size_t id           = Id;
+        static constexpr size_t num_children = sizeof...(Children);
+
+        template<size_t Index>
+        using get_child = type_list::get<tlist<Children...>, Index>;
+    };
+
+    template<size_t Depth, size_t Id, typename Indices = std::make_index_sequence<fan_out>>
+    struct make_tree;
+
+    template<size_t Depth, size_t Id, size_t... Is>
+    struct make_tree<Depth, Id, std::index_sequence<Is...>>
+    {
+        static constexpr size_t child_size = make_tree<Depth - 1, 0>::size;
+        static constexpr size_t size       = 1 + fan_out * child_size;
+
+        using type = node<Id, typename make_tree<Depth - 1, Id + 1 + Is * child_size>::type...>;
+    };
+
+    template<size_t Id, size_t... Is>
+    struct make_tree<0, Id, std::index_sequence<Is...>>
+    {
+        static constexpr size_t size = 1;
+
+        using type = node<Id>;
+    };
+
+    using tree = typename make_tree<depth, 0>::type;
+
+    template<typename Node>
+    struct id_of : std::integral_constant<std::uint32_t, Node::id> {};
+
+    static constexpr const auto& table = flatten_tree_v<tree, contexts::intrusive, traversals::nlr, id_of>;
+
+    static constexpr size_t size = table.size();
+
+    static_assert(size == make_tree<depth, 0>::size && table[size - 1].value == size - 1);
+
+    constexpr bool pruned(std::uint32_t value)
+    {
+        return value % 8 == 0;
+    }
+
+    std::uint64_t table_walk(const std::uint32_t* values)
+    {
+        std::uint64_t sum = 0;
+        for(const auto& record : table) {
+            sum += values[record.value];
+        }
+        return sum;
+    }
+
+    std::uint64_t table_walk_pruned(const std::uint32_t* values)
+    {
+        std::uint64_t sum = 0;
+        for(size_t i = 0; i < size;) {
+            const std::uint32_t value = values[table[i].value];
+            if(pruned(value)) {
+                i = table[i].subtree_end;
+            } else {
+                sum += value;
+                ++i;
+            }
+        }
+        return sum;
+    }
+
+    template<size_t Id, typename... Children>
+    inline void visit(node<Id, Children...>, const std::uint32_t* values, std::uint64_t& sum)
+    {
+        sum += values[Id];
+        (visit(Children{}, values, sum), ...);
+    }
+
+    template<size_t Id, typename... Children>
+    inline void visit_pruned(node<Id, Children...>, const std::uint32_t* values, std::uint64_t& sum)
+    {
+        const std::uint32_t value = values[Id];
+        if(pruned(value)) {
+            return;
+        }
+        sum += value;
+        (visit_pruned(Children{}, values, sum), ...);
+    }
+
+    std::uint64_t recursive_walk(const std::uint32_t* values)
+    {
+        std::uint64_t sum = 0;
+        visit(tree{}, values, sum);
+        return sum;
+    }
+
+    std::uint64_t recursive_walk_pruned(const std::uint32_t* values)
+    {
+        std::uint64_t sum = 0;
+        visit_pruned(tree{}, values, sum);
+        return sum;
+    }
+
+    // time per walk in microseconds, the sum keeps the walks from being dropped
+    template<typename Walk>
+    double measure(Walk walk, std::vector<std::uint32_t> values, std::uint64_t& sum)
+    {
+        static constexpr size_t repetitions = 20000;
+
+        std::mt19937 random(42);
+        const auto start = std::chrono::steady_clock::now();
+        for(size_t rep = 0; rep < repetitions; ++rep) {
+            values[rep % size] = static_cast<std::uint32_t>(random());
+            sum += walk(values.data());
+        }
+        const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / repetitions;
+    }
+
+}
+
+int main()
+{
+    using namespace meta::benchmark::tree_walk;
+
+    std::vector<std::uint32_t> values(size);
+    std::mt19937 random(7);
+    for(auto& value : values) {
+        value = static_cast<std::uint32_t>(random());
+    }
+
+    if(table_walk(values.data()) != recursive_walk(values.data()) || table_walk_pruned(values.data()) != recursive_walk_pruned(values.data())) {
+        std::puts("table and recursive walk differ");
+        return 1;
+    }
+
+    std::uint64_t sum = 0;
+    std::printf("walk      table      recursive\n");
+    std::printf("full      %.2fus     %.2fus\n", measure(table_walk, values, sum), measure(recursive_walk, values, sum));
+    std::printf("pruned    %.2fus     %.2fus\n", measure(table_walk_pruned, values, sum), measure(recursive_walk_pruned, values, sum));
+    std::printf("(%llu)\n", static_cast<unsigned long long>(sum));
+    return 0;
+}
@@ -0,0 +1,172 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Compile-time benchmark: membership and index queries on a list of META_BENCHMARK_SIZE distinct types.
+//
+// The same num_queries lookups (spread over the list, plus one miss) run either through type_list::contains /
+// index_of / find_if and type_map, or, with META_BENCHMARK_NAIVE defined, through the usual head/tail recursion.
+// The naive variant needs -ftemplate-depth above the list size.
+//
+// GCC 12, -O0, 16 queries:
+//     size      naive                   contains / index_of / type_map
+//     10        0.08s     17MB          0.08s     17MB
+//     100       0.15s     50MB          0.09s     19MB
+//     1000      18.2s   2194MB          0.26s     41MB
+//     10000     out of memory (>4GB)    10.6s    291MB
+//
+// At 10000 types most of the remaining time is spent emitting the index_of variables, whose names spell out the list.
+//
+// Measure with
+//     GCC:   -ftime-report (TOTAL line: time and GGC memory)
+//     Clang: -ftime-trace
+//
+
+#include <meta/tlist.hpp>
+#include <meta/type_map.hpp>
+#include <meta/util.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#ifndef META_BENCHMARK_SIZE
+#define META_BENCHMARK_SIZE 1000
+#endif
+
+namespace meta::benchmark::type_lookup {
+
+    static constexpr size_t list_size   = META_BENCHMARK_SIZE;
+    static constexpr size_t num_queries = list_size < 16 ? list_size : 16;
+
+    template<size_t Id>
+    struct message {};
+
+    template<size_t Id>
+    struct handler {};
+
+    template<typename T>
+    struct is_last_message : std::false_type {};
+
+    template<>
+    struct is_last_message<message<list_size - 1>> : std::true_type {};
+
+    template<typename Indices>
+    struct make_lists;
+
+    template<size_t... Is>
+    struct make_lists<std::index_sequence<Is...>>
+    {
+        using messages = tlist<message<Is>...>;
+        using routes   = tlist<std::pair<message<Is>, handler<Is>>...>;
+    };
+
+    using lists = make_lists<std::make_index_sequence<list_size>>;
+
+#ifdef META_BENCHMARK_NAIVE
+
+    template<typename T, typename... Ts>
+    struct naive_index_of
+    {
+        static constexpr size_t value = 0;
+    };
+
+    template<typename T, typename... Ts>
+    struct naive_index_of<T, T, Ts...>
+    {
+        static constexpr size_t value = 0;
+    };
+
+    template<typename T, typename U, typename... Ts>
+    struct naive_index_of<T, U, Ts...>
+    {
+        static constexpr size_t value = 1 + naive_index_of<T, Ts...>::value;
+    };
+
+    template<template<typename> typename Predicate, typename... Ts>
+    struct naive_find_if
+    {
+        static constexpr size_t value = 0;
+    };
+
+    template<template<typename> typename Predicate, typename T, typename... Ts>
+    struct naive_find_if<Predicate, T, Ts...>
+    {
+        static constexpr size_t value = Predicate<T>::value ? 0 : 1 + naive_find_if<Predicate, Ts...>::value;
+    };
+
+    template<typename Key, typename... Pairs>
+    struct naive_at
+    {
+        using type = error_type;
+    };
+
+    template<typename Key, typename Value, typename... Pairs>
+    struct naive_at<Key, std::pair<Key, Value>, Pairs...>
+    {
+        using type = Value;
+    };
+
+    template<typename Key, typename Pair, typename... Pairs>
+    struct naive_at<Key, Pair, Pairs...>
+    {
+        using type = typename naive_at<Key, Pairs...>::type;
+    };
+
+    template<typename List, typename T>
+    struct index_of;
+
+    template<typename... Ts, typename T>
+    struct index_of<tlist<Ts...>, T> : naive_index_of<T, Ts...> {};
+
+    template<typename List, typename T>
+    constexpr bool contains = index_of<List, T>::value != type_list::size<List>;
+
+    template<typename List, template<typename> typename Predicate>
+    struct find_if;
+
+    template<typename... Ts, template<typename> typename Predicate>
+    struct find_if<tlist<Ts...>, Predicate> : naive_find_if<Predicate, Ts...> {};
+
+    template<typename Map, typename Key>
+    struct at;
+
+    template<typename... Pairs, typename Key>
+    struct at<tlist<Pairs...>, Key> : naive_at<Key, Pairs...> {};
+
+    static_assert(find_if<lists::messages, is_last_message>::value == list_size - 1);
+
+    template<size_t Query>
+    constexpr bool check =
+        contains<lists::messages, message<Query>> &&
+        index_of<lists::messages, message<Query>>::value == Query &&
+        std::is_same_v<typename at<lists::routes, message<Query>>::type, handler<Query>>;
+
+    static_assert(!contains<lists::messages, message<list_size>>);
+
+#else
+
+    using routes = type_map<lists::routes>;
+
+    static_assert(type_list::find_if<lists::messages, is_last_message> == list_size - 1);
+
+    template<size_t Query>
+    constexpr bool check =
+        type_list::contains<lists::messages, message<Query>> &&
+        type_list::index_of<lists::messages, message<Query>> == Query &&
+        std::is_same_v<routes::at<message<Query>>, handler<Query>>;
+
+    static_assert(!type_list::contains<lists::messages, message<list_size>>);
+
+#endif
+
+    template<size_t... Qs>
+    constexpr bool check_all(std::index_sequence<Qs...>)
+    {
+        return (check<((Qs + 1) * list_size) / num_queries - 1> && ...);
+    }
+
+    static_assert(check_all(std::make_index_sequence<num_queries>{}));
+
+}
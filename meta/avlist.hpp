@@ -0,0 +1,209 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef META_AVLIST_HPP___
+#define META_AVLIST_HPP___
+
+#include "common.hpp"
+#include "vlist.hpp"
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+namespace meta
+{
+    namespace common::detail {
+
+        template<const auto& Values>
+        using array_value_type = typename std::remove_cvref_t<decltype(Values)>::value_type;
+
+        template<const auto& Values, typename Transform>
+        inline constexpr auto transformed_array = [] {
+            using T      = array_value_type<Values>;
+            using Result = std::remove_cvref_t<std::invoke_result_t<const Transform&, const T&>>;
+            const Transform transform{};
+            std::array<Result, Values.size()> result{};
+            const T* from = Values.data();
+            Result* to    = result.data();
+            for(size_t i = 0; i < Values.size(); ++i) {
+                to[i] = transform(from[i]);
+            }
+            return result;
+        }();
+
+        template<const auto& Values, typename Predicate, bool Keep>
+        inline constexpr size_t filtered_size = [] {
+            const Predicate predicate{};
+            const array_value_type<Values>* from = Values.data();
+            size_t count = 0;
+            for(size_t i = 0; i < Values.size(); ++i) {
+                count += (static_cast<bool>(predicate(from[i])) == Keep);
+            }
+            return count;
+        }();
+
+        template<const auto& Values, typename Predicate, bool Keep>
+        inline constexpr auto filtered_array = [] {
+            using T = array_value_type<Values>;
+            const Predicate predicate{};
+            std::array<T, filtered_size<Values, Predicate, Keep>> result{};
+            const T* from = Values.data();
+            T* to         = result.data();
+            for(size_t i = 0; i < Values.size(); ++i) {
+                if(static_cast<bool>(predicate(from[i])) == Keep) {
+                    *to++ = from[i];
+                }
+            }
+            return result;
+        }();
+
+        template<concepts::ValueList List>
+        struct vlist_array;
+
+        template<template<typename X, X...> typename XList, typename T, T... Vs>
+        struct vlist_array<XList<T, Vs...>>
+        {
+            using type = avlist<value_array<T, Vs...>::values>;
+        };
+
+        template<concepts::ArrayValueList List, template<typename X, X...> typename XList>
+        struct avlist_vlist;
+
+        template<const auto& Values, template<typename X, X...> typename XList>
+        struct avlist_vlist<avlist<Values>, XList>
+        {
+            using type = typename array_vlist<XList, Values>::type;
+        };
+
+    }
+
+    namespace common {
+
+        template<const auto& Values>
+        struct value_type<avlist<Values>>
+        {
+            using type = detail::array_value_type<Values>;
+        };
+
+        template<const auto& Values, typename Compare>
+        struct sort_vlist<avlist<Values>, Compare>
+        {
+            using type = avlist<detail::sorted_array<Values, Compare>>;
+        };
+
+    }
+
+    //
+    // The queries of value_list on an avlist: size, is_empty, front, back, get, to_array (the referenced array itself),
+    // sort and lookup work on it like on any value list.
+    //
+    namespace value_list {
+
+        template<const auto& Values>
+        constexpr size_t size<avlist<Values>> = Values.size();
+
+        template<const auto& Values>
+        requires(Values.size() > 0)
+        constexpr common::detail::array_value_type<Values> front<avlist<Values>> = Values[0];
+
+        template<const auto& Values>
+        requires(Values.size() > 0)
+        constexpr common::detail::array_value_type<Values> back<avlist<Values>> = Values[Values.size() - 1];
+
+        template<const auto& Values, size_t N>
+        constexpr common::detail::array_value_type<Values> get<avlist<Values>, N> = Values[N];
+
+        template<const auto& Values>
+        constexpr const auto& to_array<avlist<Values>> = Values;
+
+    }
+
+    //
+    // array_value_list
+    // The algorithms of value_list that take a class template instantiated per value (transform, erase_if, copy_if)
+    // take a default constructible constexpr callable (f.e. a lambda type) for avlist instead, which runs once per
+    // value inside a single constant evaluation. The other algorithms of value_list are reached through to_vlist /
+    // from_vlist.
+    //
+    namespace array_value_list {
+
+        template<typename T>
+        constexpr bool is_array_value_list = concepts::ArrayValueList<T>;
+
+        // transform< List, Transform >
+        // Transform{}( value ) for every value, the value type of the result is that of the call
+        template<concepts::ArrayValueList List, typename Transform>
+        using transform = avlist<common::detail::transformed_array<List::values, Transform>>;
+
+        // erase_if< List, Predicate >
+        // values for which Predicate{}( value ) is false
+        template<concepts::ArrayValueList List, typename Predicate>
+        using erase_if = avlist<common::detail::filtered_array<List::values, Predicate, false>>;
+
+        // copy_if< List, Predicate >
+        // values for which Predicate{}( value ) is true
+        template<concepts::ArrayValueList List, typename Predicate>
+        using copy_if = avlist<common::detail::filtered_array<List::values, Predicate, true>>;
+
+        // to_vlist< List, XList >
+        // XList<value_type, values...>, the values enter the type in chunks, see common::detail::array_vlist
+        template<concepts::ArrayValueList List, template<typename X, X...> typename XList = vlist>
+        using to_vlist = typename common::detail::avlist_vlist<List, XList>::type;
+
+        // from_vlist< List >
+        // avlist of the values of a value list
+        template<concepts::ValueList List>
+        using from_vlist = typename common::detail::vlist_array<List>::type;
+
+    }
+
+    //
+    // avlist< Values >
+    // Array-backed value list for large constant tables. Values is a constexpr std::array with static storage duration
+    // (f.e. a namespace scope constexpr variable), the list refers to it instead of carrying every value as a template
+    // argument. Neither the type nor the mangled names of anything instantiated on it grow with the table, get is a
+    // constant array read, and transform / filter / sort are constexpr loops whose results are stored in variable
+    // templates named after their inputs.
+    //
+    template<const auto& Values>
+    struct avlist
+    {
+        using value_type = common::detail::array_value_type<Values>;
+
+        static constexpr const auto& values = Values;
+
+        static constexpr size_t size = Values.size();
+
+        static constexpr bool is_empty = (size == 0);
+
+        template<concepts::ArrayValueList Self = avlist>
+        static constexpr value_type front = value_list::front<Self>;
+
+        template<concepts::ArrayValueList Self = avlist>
+        static constexpr value_type back = value_list::back<Self>;
+
+        template<size_t N>
+        static constexpr value_type get = value_list::get<avlist, N>;
+
+        template<typename Transform>
+        using transform = array_value_list::transform<avlist, Transform>;
+
+        template<typename Predicate>
+        using erase_if = array_value_list::erase_if<avlist, Predicate>;
+
+        template<typename Predicate>
+        using copy_if = array_value_list::copy_if<avlist, Predicate>;
+
+        template<typename Compare = std::less<>>
+        using sort = value_list::sort<avlist, Compare>;
+
+        template<template<typename X, X...> typename XList = vlist>
+        using to_vlist = array_value_list::to_vlist<avlist, XList>;
+    };
+
+} // namespace meta
+
+#endif
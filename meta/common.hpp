@@ -8,9 +8,40 @@
 
 #include <type_traits>
 #include <cstddef>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <bit>
 #include "predicates.hpp"
 
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define META_HAS_TYPE_PACK_ELEMENT
+#endif
+#if __has_builtin(__is_same)
+#define META_HAS_IS_SAME
+#endif
+#endif
+
 namespace meta {
+
+    // array-backed value list, see avlist.hpp
+    template<const auto& Values>
+    struct avlist;
+
+    namespace detail {
+
+        // the smallest unsigned type holding 0 ... Max
+        template<size_t Max>
+        using smallest_unsigned_t =
+            std::conditional_t<(Max <= UINT8_MAX), std::uint8_t,
+            std::conditional_t<(Max <= UINT16_MAX), std::uint16_t,
+            std::conditional_t<(Max <= UINT32_MAX), std::uint32_t, std::uint64_t>>>;
+
+    }
+
     namespace concepts {
 
         // TypeList concept
@@ -51,6 +82,30 @@ namespace meta {
         template<typename T>
         concept ValueList = detail::is_value_list<T>::value;
 
+        // ArrayValueList concept
+
+        namespace detail {
+            template<typename T>
+            struct is_array_value_list
+            {
+                static constexpr bool value = false;
+            };
+
+            template<const auto& Values>
+            struct is_array_value_list<avlist<Values>>
+            {
+                static constexpr bool value = true;
+            };
+        }
+
+        template<typename T>
+        concept ArrayValueList = detail::is_array_value_list<T>::value;
+
+        // AnyValueList concept, the lists the queries of value_list (size, get, to_array, sort...) take
+
+        template<typename T>
+        concept AnyValueList = ValueList<T> || ArrayValueList<T>;
+
         // MetaObject concept
 
         template<typename T>
@@ -162,7 +217,7 @@ namespace meta {
         template <concepts::TypeList List, typename Arg>
         using push_front_tlist_t = typename push_front_tlist<List, Arg>::type;
 
-        template<concepts::ValueList List>
+        template<concepts::AnyValueList List>
         struct value_type;
 
         template<template <typename X, X...> typename XList, typename T, T... Vs>
@@ -171,16 +226,27 @@ namespace meta {
             using type = T;
         };
 
-        template<concepts::ValueList List>
+        template<concepts::AnyValueList List>
         using value_type_t = typename value_type<List>::type;
 
-        template <concepts::ValueList List, value_type_t<List> Element>
-        struct push_front_vlist;
+        namespace detail {
+
+            // Arg is auto, a parameter of the dependent type value_type_t<List> would make the specialization no more
+            // specialized than the primary template
+            template <typename List, auto Arg>
+            struct push_front_vlist;
+
+            template <template <typename X, X...> typename XList, typename T, T... Vs, auto Arg>
+            struct push_front_vlist<XList<T, Vs...>, Arg>
+            {
+                using type = XList<T, Arg, Vs...>;
+            };
 
-        template <template <typename X, X...> typename XList, typename T, T... Vs, T Arg>
-        struct push_front_vlist<XList<T, Vs...>, Arg>
+        }
+
+        template <concepts::ValueList List, value_type_t<List> Element>
+        struct push_front_vlist : detail::push_front_vlist<List, Element>
         {
-            using type = XList<T, Arg, Vs...>;
         };
 
         template <concepts::ValueList List, value_type_t<List> V>
@@ -202,18 +268,332 @@ namespace meta {
         template <concepts::TypeList List, typename Arg>
         using push_back_tlist_t = typename push_back_tlist<List, Arg>::type;
 
-        template <concepts::ValueList List, value_type_t<List> Element>
-        struct push_back_vlist;
+        namespace detail {
+
+            template <typename List, auto Arg>
+            struct push_back_vlist;
+
+            template <template <typename X, X...> typename XList, typename T, T... Vs, auto Arg>
+            struct push_back_vlist<XList<T, Vs...>, Arg>
+            {
+                using type = XList<T, Vs..., Arg>;
+            };
+
+        }
 
-        template <template <typename X, X...> typename XList, typename T, T... Vs, T Arg>
-        struct push_back_vlist<XList<T, Vs...>, Arg>
+        template <concepts::ValueList List, value_type_t<List> Element>
+        struct push_back_vlist : detail::push_back_vlist<List, Element>
         {
-            using type = XList<T, Vs..., Arg>;
         };
 
         template <concepts::ValueList List, value_type_t<List> Arg>
         using push_back_vlist_t = typename push_back_vlist<List, Arg>::type;
 
+        //
+        // indexing
+        // Constant-depth access to the Nth element of a pack. Types use the compiler's pack-indexing builtin where
+        // available and fall back to overload resolution against a set of (index, type) bases otherwise. Values are
+        // read from a constexpr array.
+        //
+
+        namespace detail {
+
+            // plain holder for intermediate packs (integral constants, lists of lists)
+            template<typename... Ts>
+            struct pack
+            {
+            };
+
+            template<size_t Index, typename T>
+            struct indexed_type
+            {
+                using type = T;
+
+                static constexpr size_t index = Index;
+            };
+
+            template<typename Indices, typename... Ts>
+            struct indexed_types;
+
+            template<size_t... Is, typename... Ts>
+            struct indexed_types<std::index_sequence<Is...>, Ts...> : indexed_type<Is, Ts>...
+            {
+            };
+
+            template<size_t Index, typename T>
+            indexed_type<Index, T> select_indexed(const indexed_type<Index, T>&);
+
+#ifdef META_HAS_TYPE_PACK_ELEMENT
+            template<size_t N, typename... Ts>
+            using type_at_t = __type_pack_element<N, Ts...>;
+#else
+            template<size_t N, typename... Ts>
+            using type_at_t = typename decltype(
+                detail::select_indexed<N>(std::declval<indexed_types<std::index_sequence_for<Ts...>, Ts...>>())
+            )::type;
+#endif
+
+            template<typename T, T... Vs>
+            struct value_array
+            {
+                static constexpr std::array<T, sizeof...(Vs)> values = { Vs... };
+            };
+
+            // drop the first sizeof...(Is) types of a pack by matching them against void pointers
+            template<size_t>
+            using void_ptr = const void*;
+
+            template<template<typename...> typename XList, typename Indices>
+            struct drop_front;
+
+            template<template<typename...> typename XList, size_t... Is>
+            struct drop_front<XList, std::index_sequence<Is...>>
+            {
+                template<typename... Rest>
+                static XList<Rest...> apply(void_ptr<Is>..., std::type_identity<Rest>*...);
+            };
+
+            // detail get nth type
+            template<size_t N, typename... Types>
+            requires(N < sizeof...(Types))
+            struct get_tlist
+            {
+                using type = type_at_t<N, Types...>;
+            };
+
+            // detail get nth value
+            template<size_t N, typename T, T... Vs>
+            requires(N < sizeof...(Vs))
+            struct get_vlist
+            {
+                static constexpr T value = value_array<T, Vs...>::values[N];
+            };
+        }
+
+        //
+        // reverse / take_front
+        // With the pack-indexing builtin both are a single pack expansion. Without it they are state machines peeling
+        // 64, 8 or 1 elements per step, driven by iterate, so the template depth grows with the logarithm of the list
+        // size instead of the size.
+        //
+
+        namespace detail {
+
+            // iterate< State, Level >
+            // follows State::next 8^Level times, iteration_done is its own next
+            template<typename Result>
+            struct iteration_done
+            {
+                using next = iteration_done;
+                using type = Result;
+            };
+
+            template<typename State, size_t Level>
+            struct iterate
+            {
+                using type = typename iterate<
+                    typename iterate<
+                        typename iterate<
+                            typename iterate<
+                                typename iterate<
+                                    typename iterate<
+                                        typename iterate<
+                                            typename iterate<State, Level - 1>::type,
+                                        Level - 1>::type,
+                                    Level - 1>::type,
+                                Level - 1>::type,
+                            Level - 1>::type,
+                        Level - 1>::type,
+                    Level - 1>::type,
+                Level - 1>::type;
+            };
+
+            template<typename State>
+            struct iterate<State, 1>
+            {
+                using type = typename State::next::next::next::next::next::next::next::next;
+            };
+
+            template<typename Result, size_t Level>
+            struct iterate<iteration_done<Result>, Level>
+            {
+                using type = iteration_done<Result>;
+            };
+
+            template<typename Result>
+            struct iterate<iteration_done<Result>, 1>
+            {
+                using type = iteration_done<Result>;
+            };
+
+            constexpr size_t iteration_levels(size_t steps)
+            {
+                size_t levels = 1;
+                for(size_t covered = 8; covered < steps; covered *= 8) {
+                    ++levels;
+                }
+                return levels;
+            }
+
+            template<typename State, size_t Steps>
+            using iterate_t = typename iterate<State, iteration_levels(Steps + 1)>::type::type;
+
+#ifdef META_HAS_TYPE_PACK_ELEMENT
+            template<typename Result, typename Indices, typename... Ts>
+            struct reverse_indexed;
+
+            template<template<typename...> typename XList, size_t... Is, typename... Ts>
+            struct reverse_indexed<XList<>, std::index_sequence<Is...>, Ts...>
+            {
+                using type = XList<type_at_t<sizeof...(Ts) - 1 - Is, Ts...>...>;
+            };
+
+            template<typename Result, typename... Ts>
+            struct reverse_types : reverse_indexed<Result, std::index_sequence_for<Ts...>, Ts...>
+            {
+            };
+
+            template<typename Result, typename Head, typename Tail, typename... Ts>
+            struct take_indexed;
+
+            template<template<typename...> typename XList, size_t... Is, size_t... Js, typename... Ts>
+            struct take_indexed<XList<>, std::index_sequence<Is...>, std::index_sequence<Js...>, Ts...>
+            {
+                using type = XList<type_at_t<Is, Ts...>...>;
+                using rest = pack<type_at_t<sizeof...(Is) + Js, Ts...>...>;
+            };
+
+            template<size_t N, typename Result, typename... Ts>
+            struct take_front : take_indexed<Result, std::make_index_sequence<N>, std::make_index_sequence<sizeof...(Ts) - N>, Ts...>
+            {
+            };
+#else
+            // the steps take the largest block that fits, so a list of N elements is done after N / 64 + 14 steps
+            template<typename Result, typename... Ts>
+            struct reverse_step
+            {
+                using next = iteration_done<Result>;
+            };
+
+            template<template<typename...> typename XList, typename... Rs, typename T0, typename... Ts>
+            struct reverse_step<XList<Rs...>, T0, Ts...>
+            {
+                using next = reverse_step<XList<T0, Rs...>, Ts...>;
+            };
+
+            template<template<typename...> typename XList, typename... Rs, typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename... Ts>
+            struct reverse_step<XList<Rs...>, T0, T1, T2, T3, T4, T5, T6, T7, Ts...>
+            {
+                using next = reverse_step<XList<T7, T6, T5, T4, T3, T2, T1, T0, Rs...>, Ts...>;
+            };
+
+            template<template<typename...> typename XList, typename... Rs,
+                    typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7,
+                    typename T8, typename T9, typename T10, typename T11, typename T12, typename T13, typename T14, typename T15,
+                    typename T16, typename T17, typename T18, typename T19, typename T20, typename T21, typename T22, typename T23,
+                    typename T24, typename T25, typename T26, typename T27, typename T28, typename T29, typename T30, typename T31,
+                    typename T32, typename T33, typename T34, typename T35, typename T36, typename T37, typename T38, typename T39,
+                    typename T40, typename T41, typename T42, typename T43, typename T44, typename T45, typename T46, typename T47,
+                    typename T48, typename T49, typename T50, typename T51, typename T52, typename T53, typename T54, typename T55,
+                    typename T56, typename T57, typename T58, typename T59, typename T60, typename T61, typename T62, typename T63,
+                    typename... Ts>
+            struct reverse_step<XList<Rs...>,
+                    T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15,
+                    T16, T17, T18, T19, T20, T21, T22, T23, T24, T25, T26, T27, T28, T29, T30, T31,
+                    T32, T33, T34, T35, T36, T37, T38, T39, T40, T41, T42, T43, T44, T45, T46, T47,
+                    T48, T49, T50, T51, T52, T53, T54, T55, T56, T57, T58, T59, T60, T61, T62, T63,
+                    Ts...>
+            {
+                using next = reverse_step<XList<
+                    T63, T62, T61, T60, T59, T58, T57, T56, T55, T54, T53, T52, T51, T50, T49, T48,
+                    T47, T46, T45, T44, T43, T42, T41, T40, T39, T38, T37, T36, T35, T34, T33, T32,
+                    T31, T30, T29, T28, T27, T26, T25, T24, T23, T22, T21, T20, T19, T18, T17, T16,
+                    T15, T14, T13, T12, T11, T10, T9, T8, T7, T6, T5, T4, T3, T2, T1, T0,
+                    Rs...>, Ts...>;
+            };
+
+            template<typename Result, typename... Ts>
+            struct reverse_types
+            {
+                using type = iterate_t<reverse_step<Result, Ts...>, sizeof...(Ts) / 64 + 14>;
+            };
+
+            template<typename Result, typename... Ts>
+            struct take_front_done
+            {
+                using type = Result;
+                using rest = pack<Ts...>;
+            };
+
+            template<size_t N, typename Result, typename... Ts>
+            struct take_front_step
+            {
+                using next = iteration_done<take_front_done<Result, Ts...>>;
+            };
+
+            template<size_t N, template<typename...> typename XList, typename... Rs, typename T0, typename... Ts>
+            requires(N > 0)
+            struct take_front_step<N, XList<Rs...>, T0, Ts...>
+            {
+                using next = take_front_step<N - 1, XList<Rs..., T0>, Ts...>;
+            };
+
+            template<size_t N, template<typename...> typename XList, typename... Rs, typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename... Ts>
+            requires(N >= 8)
+            struct take_front_step<N, XList<Rs...>, T0, T1, T2, T3, T4, T5, T6, T7, Ts...>
+            {
+                using next = take_front_step<N - 8, XList<Rs..., T0, T1, T2, T3, T4, T5, T6, T7>, Ts...>;
+            };
+
+            template<size_t N, template<typename...> typename XList, typename... Rs,
+                    typename T0, typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7,
+                    typename T8, typename T9, typename T10, typename T11, typename T12, typename T13, typename T14, typename T15,
+                    typename T16, typename T17, typename T18, typename T19, typename T20, typename T21, typename T22, typename T23,
+                    typename T24, typename T25, typename T26, typename T27, typename T28, typename T29, typename T30, typename T31,
+                    typename T32, typename T33, typename T34, typename T35, typename T36, typename T37, typename T38, typename T39,
+                    typename T40, typename T41, typename T42, typename T43, typename T44, typename T45, typename T46, typename T47,
+                    typename T48, typename T49, typename T50, typename T51, typename T52, typename T53, typename T54, typename T55,
+                    typename T56, typename T57, typename T58, typename T59, typename T60, typename T61, typename T62, typename T63,
+                    typename... Ts>
+            requires(N >= 64)
+            struct take_front_step<N, XList<Rs...>,
+                    T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15,
+                    T16, T17, T18, T19, T20, T21, T22, T23, T24, T25, T26, T27, T28, T29, T30, T31,
+                    T32, T33, T34, T35, T36, T37, T38, T39, T40, T41, T42, T43, T44, T45, T46, T47,
+                    T48, T49, T50, T51, T52, T53, T54, T55, T56, T57, T58, T59, T60, T61, T62, T63,
+                    Ts...>
+            {
+                using next = take_front_step<N - 64, XList<Rs...,
+                    T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15,
+                    T16, T17, T18, T19, T20, T21, T22, T23, T24, T25, T26, T27, T28, T29, T30, T31,
+                    T32, T33, T34, T35, T36, T37, T38, T39, T40, T41, T42, T43, T44, T45, T46, T47,
+                    T48, T49, T50, T51, T52, T53, T54, T55, T56, T57, T58, T59, T60, T61, T62, T63>,
+                    Ts...>;
+            };
+
+            template<size_t N, typename Result, typename... Ts>
+            struct take_front : iterate_t<take_front_step<N, Result, Ts...>, N / 64 + 14>
+            {
+            };
+#endif
+
+            // Value lists are reversed and truncated as packs of integral constants, indexing into a constexpr array
+            // would copy the whole array for every element.
+
+            template<concepts::ValueList List, typename Pack>
+            struct unwrap_values;
+
+            template<template<typename X, X...> typename XList, typename T, typename... Cs>
+            struct unwrap_values<XList<T>, pack<Cs...>>
+            {
+                using type = XList<T, Cs::value...>;
+            };
+
+            template<concepts::ValueList List, typename Pack>
+            using unwrap_values_t = typename unwrap_values<List, Pack>::type;
+
+        }
+
         //
         // reverse
         //
@@ -224,28 +604,19 @@ namespace meta {
         template<concepts::MetaObject Object>
         using reverse_t = typename reverse<Object>::type;
 
-        template <template <typename...> typename XList>
-        struct reverse<XList<>>
-        {
-            using type = XList<>;
-        };
-
-        template <template <typename...> typename XList, typename T0, typename... Ts>
-        struct reverse<XList<T0, Ts...>>
-        {
-            using type = push_back_tlist_t<reverse_t<XList<Ts...>>, T0>;
-        };
-
-        template <template <typename X, X...> typename XList, typename T>
-        struct reverse<XList<T>>
+        template <template <typename...> typename XList, typename... Ts>
+        struct reverse<XList<Ts...>>
         {
-            using type = XList<T>;
+            using type = typename detail::reverse_types<XList<>, Ts...>::type;
         };
 
-        template <template <typename T, T...> typename XList, typename T, T V0, T... Vs>
-        struct reverse<XList<T, V0, Vs...>>
+        template <template <typename X, X...> typename XList, typename T, T... Vs>
+        struct reverse<XList<T, Vs...>>
         {
-            using type = push_back_vlist_t<reverse_t<XList<T, Vs...>>, V0>;
+            using type = detail::unwrap_values_t<
+                XList<T>,
+                typename detail::reverse_types<detail::pack<>, std::integral_constant<T, Vs>...>::type
+            >;
         };
 
         //
@@ -273,14 +644,25 @@ namespace meta {
 
         //
         // pop_back
-        // Todo: Implementation using "reverse" is probably inefficient...
         //
 
         template <concepts::MetaObject Object>
         requires(size_v<Object> > 0)
-        struct pop_back
+        struct pop_back;
+
+        template <template <typename...> typename XList, typename... Ts>
+        struct pop_back<XList<Ts...>>
         {
-            using type = reverse_t<pop_front_t<reverse_t<Object>>>;
+            using type = typename detail::take_front<sizeof...(Ts) - 1, XList<>, Ts...>::type;
+        };
+
+        template <template <typename X, X...> typename XList, typename T, T... Vs>
+        struct pop_back<XList<T, Vs...>>
+        {
+            using type = detail::unwrap_values_t<
+                XList<T>,
+                typename detail::take_front<sizeof...(Vs) - 1, detail::pack<>, std::integral_constant<T, Vs>...>::type
+            >;
         };
 
         template <concepts::MetaObject Object>
@@ -369,29 +751,6 @@ namespace meta {
         template<concepts::ValueList List>
         static constexpr common::value_type_t<List> back_vlist_v = back_vlist<List>::value;
 
-        //
-        // concat
-        //
-
-        template<concepts::MetaObject List1, concepts::MetaObject List2>
-        requires (same_type_list_type_v<List1, List2> || same_value_list_type_v<List1, List2>)
-        struct concat;
-
-        template<template<typename...> typename XList, typename... Ts1, typename... Ts2 >
-        struct concat<XList<Ts1...>, XList<Ts2...>>
-        {
-            using type = XList<Ts1..., Ts2...>;
-        };
-
-        template<template<typename X, X...> typename XList, typename T, T... Vs1, T... Vs2 >
-        struct concat<XList<T, Vs1...>, XList<T, Vs2...>>
-        {
-            using type = XList<T, Vs1..., Vs2...>;
-        };
-
-        template<concepts::MetaObject List1, concepts::MetaObject List2>
-        using concat_t = typename concat<List1, List2>::type;
-
         //
         // transform_tlist
         //
@@ -424,46 +783,6 @@ namespace meta {
         template<concepts::ValueList List, template <auto Value> typename Transformer>
         using transform_vlist_t = typename transform_vlist<List, Transformer>::type;
 
-        //
-        // get
-        //
-
-        namespace detail {
-            // detail get nth type
-            template<size_t N, typename... Types>
-            requires(N < sizeof...(Types))
-            struct get_tlist;
-
-            template<typename T0, typename... Ts>
-            struct get_tlist<0, T0, Ts...>
-            {
-                using type = T0;
-            };
-
-            template<size_t N, typename T0, typename... Ts>
-            struct get_tlist<N, T0, Ts...>
-            {
-                using type = typename get_tlist<N-1, Ts...>::type;
-            };
-
-            // detail get nth value
-            template<size_t N, typename T, T... Vs>
-            requires(N < sizeof...(Vs))
-            struct get_vlist;
-
-            template<typename T, T V0, T... Vs>
-            struct get_vlist<0, T, V0, Vs...>
-            {
-                static constexpr T value = V0;
-            };
-
-            template<size_t N, typename T, T V0, T... Vs>
-            struct get_vlist<N, T, V0, Vs...>
-            {
-                static constexpr T value = get_vlist<N-1, T, Vs...>::value;
-            };
-        }
-
         //
         // get_tlist
         //
@@ -498,119 +817,1121 @@ namespace meta {
         static constexpr auto get_vlist_v = get_vlist<List, N>::value;
 
         //
-        // split
+        // to_array_vlist / to_array_tlist
+        // The values of a list as a constexpr std::array in static storage. The array is keyed on the value type and the
+        // values alone, not on the list template, so identical sequences share one object. It is an inline variable,
+        // every translation unit that uses it emits the same comdat symbol and the linker keeps a single copy.
+        // For type lists, the array holds Projection<T>::value of every element.
         //
 
+        template<concepts::ValueList List>
+        struct to_array_vlist;
+
+        template<template <typename X, X...> typename XList, typename T, T... Vs>
+        struct to_array_vlist<XList<T, Vs...>>
+        {
+            static constexpr const std::array<T, sizeof...(Vs)>& value = detail::value_array<T, Vs...>::values;
+        };
+
+        template<concepts::ValueList List>
+        constexpr const auto& to_array_vlist_v = to_array_vlist<List>::value;
+
         namespace detail {
 
-            template<concepts::MetaObject Lhs, concepts::MetaObject Rhs, size_t Where>
-            struct split_t;
+            template<concepts::TypeList List, template<typename T> typename Projection>
+            struct projection_type;
+
+            template<template <typename...> typename XList, typename T, typename... Ts, template<typename X> typename Projection>
+            struct projection_type<XList<T, Ts...>, Projection>
+            {
+                using type = std::remove_cvref_t<decltype(Projection<T>::value)>;
+            };
+
+        }
+
+        template<
+            concepts::TypeList List, template<typename T> typename Projection,
+            typename T = typename detail::projection_type<List, Projection>::type
+        >
+        struct to_array_tlist;
+
+        template<template <typename...> typename XList, typename... Ts, template<typename X> typename Projection, typename T>
+        struct to_array_tlist<XList<Ts...>, Projection, T>
+        {
+            static constexpr const std::array<T, sizeof...(Ts)>& value =
+                detail::value_array<T, static_cast<T>(Projection<Ts>::value)...>::values;
+        };
+
+        //
+        // split
+        //
 
-            template<concepts::TypeList Lhs, concepts::TypeList Rhs, size_t Where>
-            struct split_t<Lhs, Rhs, Where> : public split_t<push_back_tlist_t<Lhs, front_tlist_t<Rhs>>, pop_front_t<Rhs>, Where-1>
-            {};
+        namespace detail {
 
+            template<concepts::MetaObject List, size_t Where,
+                     typename LhsIndices = std::make_index_sequence<Where>,
+                     typename RhsIndices = std::make_index_sequence<size_v<List> - Where>>
+            struct split_t;
 
-            template<concepts::ValueList Lhs, concepts::ValueList Rhs, size_t Where>
-            struct split_t<Lhs, Rhs, Where> : public split_t<push_back_vlist_t<Lhs, front_vlist_v<Rhs>>, pop_front_t<Rhs>, Where-1>
-            {};
+            template<template<typename...> typename XList, typename... Ts, size_t Where, size_t... Ls, size_t... Rs>
+            struct split_t<XList<Ts...>, Where, std::index_sequence<Ls...>, std::index_sequence<Rs...>>
+            {
+                using lhs = typename take_front<Where, XList<>, Ts...>::type;
+                using rhs = decltype(drop_front<XList, std::index_sequence<Ls...>>::apply(
+                    static_cast<std::type_identity<Ts>*>(nullptr)...
+                ));
+            };
 
-            template<concepts::MetaObject Lhs, concepts::MetaObject Rhs>
-            struct split_t<Lhs, Rhs, 0>
+            template<template<typename X, X...> typename XList, typename T, T... Vs, size_t Where, size_t... Ls, size_t... Rs>
+            struct split_t<XList<T, Vs...>, Where, std::index_sequence<Ls...>, std::index_sequence<Rs...>>
             {
-                using lhs = Lhs;
-                using rhs = Rhs;
+                using lhs = unwrap_values_t<
+                    XList<T>,
+                    typename take_front<Where, pack<>, std::integral_constant<T, Vs>...>::type
+                >;
+                using rhs = unwrap_values_t<
+                    XList<T>,
+                    decltype(drop_front<pack, std::index_sequence<Ls...>>::apply(
+                        static_cast<std::type_identity<std::integral_constant<T, Vs>>*>(nullptr)...
+                    ))
+                >;
             };
 
         }
 
         template<concepts::MetaObject List, size_t Where>
         requires (size<List>::value >= Where)
-        struct split_t : public detail::split_t<clear_t<List>, List, Where>
+        struct split_t : public detail::split_t<List, Where>
         {
         };
 
         //
         // set
         //
-        template<concepts::TypeList List, size_t Where, typename T, typename X = split_t<List, Where>>
+
+        namespace detail {
+
+            template<concepts::TypeList List, size_t Where, typename T, typename Indices = std::make_index_sequence<size_v<List>>>
+            struct set_tlist;
+
+            template<template<typename...> typename XList, typename... Ts, size_t Where, typename T, size_t... Is>
+            struct set_tlist<XList<Ts...>, Where, T, std::index_sequence<Is...>>
+            {
+                using type = XList<std::conditional_t<Is == Where, T, Ts>...>;
+            };
+
+            template<concepts::ValueList List, size_t Where, auto V, typename Indices = std::make_index_sequence<size_v<List>>>
+            struct set_vlist;
+
+            template<template<typename X, X...> typename XList, typename T, T... Vs, size_t Where, auto V, size_t... Is>
+            struct set_vlist<XList<T, Vs...>, Where, V, std::index_sequence<Is...>>
+            {
+                using type = XList<T, (Is == Where ? V : Vs)...>;
+            };
+
+        }
+
+        template<concepts::TypeList List, size_t Where, typename T>
+        requires (Where < size_v<List>)
         struct set_tlist
         {
-            using type = concat_t<typename X::lhs, push_front_tlist_t<pop_front_t<typename X::rhs>, T>>;
+            using type = typename detail::set_tlist<List, Where, T>::type;
         };
 
         template<concepts::TypeList List, size_t Where, typename T>
         using set_tlist_t = typename set_tlist<List, Where, T>::type;
 
-        template<concepts::ValueList List, size_t Where, value_type_t<List> V, typename X = split_t<List, Where>>
+        template<concepts::ValueList List, size_t Where, value_type_t<List> V>
+        requires (Where < size_v<List>)
         struct set_vlist
         {
-            using type = concat_t<typename X::lhs, push_front_vlist_t<pop_front_t<typename X::rhs>, V>>;
+            using type = typename detail::set_vlist<List, Where, V>::type;
         };
 
-        template<concepts::ValueList List, size_t Where, value_type_t<List> V, typename X = split_t<List, Where>>
+        template<concepts::ValueList List, size_t Where, value_type_t<List> V>
         using set_vlist_t = typename set_vlist<List, Where, V>::type;
 
         //
-        // insert
+        // join
+        // Concatenate any number of lists of the same kind. The pack of lists is split in halves, so the template depth is
+        // logarithmic in the number of lists.
         //
-        template<concepts::TypeList Dst, size_t Where, concepts::TypeList Src, typename Pair = split_t<Dst, Where>>
-        requires (size<Dst>::value >= Where)
+
+        namespace detail {
+
+            template<typename Empty, typename... Lists>
+            struct join;
+
+            template<typename Empty, typename Lhs, typename Rhs>
+            struct join_halves;
+
+            template<typename Empty, typename... Ls, typename... Rs>
+            struct join_halves<Empty, pack<Ls...>, pack<Rs...>>
+            {
+                using type = typename join<Empty, typename join<Empty, Ls...>::type, typename join<Empty, Rs...>::type>::type;
+            };
+
+            template<typename Empty>
+            struct join<Empty>
+            {
+                using type = Empty;
+            };
+
+            template<typename Empty, typename List>
+            struct join<Empty, List>
+            {
+                using type = List;
+            };
+
+            template<typename Empty, template<typename...> typename XList, typename... Ts1, typename... Ts2>
+            struct join<Empty, XList<Ts1...>, XList<Ts2...>>
+            {
+                using type = XList<Ts1..., Ts2...>;
+            };
+
+            template<typename Empty, template<typename X, X...> typename XList, typename T, T... Vs1, T... Vs2>
+            struct join<Empty, XList<T, Vs1...>, XList<T, Vs2...>>
+            {
+                using type = XList<T, Vs1..., Vs2...>;
+            };
+
+            // split point near the middle that take_front reaches in whole 64 or 8 element steps
+            constexpr size_t join_split(size_t count)
+            {
+                const size_t half = count / 2;
+                return (half >= 64) ? (half & ~size_t(63)) : (half >= 8) ? (half & ~size_t(7)) : half;
+            }
+
+            template<typename Empty, typename... Lists>
+            requires(sizeof...(Lists) > 2)
+            struct join<Empty, Lists...> : join_halves<
+                Empty,
+                typename take_front<join_split(sizeof...(Lists)), pack<>, Lists...>::type,
+                typename take_front<join_split(sizeof...(Lists)), pack<>, Lists...>::rest
+            >
+            {
+            };
+
+            template<typename Empty, typename... Lists>
+            using join_t = typename join<Empty, Lists...>::type;
+
+        }
+
+        //
+        // concat
+        // Concatenate one or more lists of the same kind.
+        //
+
+        template<concepts::MetaObject List, concepts::MetaObject... Lists>
+        requires ((same_type_list_type_v<List, Lists> && ...) || (same_value_list_type_v<List, Lists> && ...))
+        struct concat
+        {
+            using type = detail::join_t<clear_t<List>, List, Lists...>;
+        };
+
+        template<concepts::MetaObject List, concepts::MetaObject... Lists>
+        using concat_t = typename concat<List, Lists...>::type;
+
+        //
+        // flatten
+        // Flatten a tree of nested type lists into the list of its leaves, in the shape contexts::tlist traverses it: every
+        // non-empty type list is an inner node, everything else (including empty lists) is a leaf. The result has the list
+        // template of the outermost list.
+        //
+
+        namespace detail {
+
+            template<template<typename...> typename XList, typename Node>
+            struct flatten_node
+            {
+                using type = XList<Node>;
+            };
+
+            template<template<typename...> typename XList, template<typename...> typename YList, typename T0, typename... Ts>
+            struct flatten_node<XList, YList<T0, Ts...>>
+            {
+                using type = join_t<XList<>, typename flatten_node<XList, T0>::type, typename flatten_node<XList, Ts>::type...>;
+            };
+
+        }
+
+        template<concepts::TypeList List>
+        struct flatten;
+
+        template<template<typename...> typename XList, typename... Ts>
+        struct flatten<XList<Ts...>>
+        {
+            using type = detail::join_t<XList<>, typename detail::flatten_node<XList, Ts>::type...>;
+        };
+
+        template<concepts::TypeList List>
+        using flatten_t = typename flatten<List>::type;
+
+        //
+        // insert
+        //
+        template<concepts::TypeList Dst, size_t Where, concepts::TypeList Src, typename Pair = split_t<Dst, Where>>
+        requires (size<Dst>::value >= Where)
         struct insert {
-            using type = concat_t< concat_t< typename Pair::lhs, Src >, typename Pair::rhs >;
+            using type = concat_t< typename Pair::lhs, Src, typename Pair::rhs >;
         };
 
         //
-        // erase_if
+        // erase_if / copy_if
+        // The predicate is evaluated once per element, each element becomes an empty or a single element list and the
+        // results are joined.
         //
 
-        template<concepts::TypeList List, template<typename T> typename Predicate, concepts::TypeList Result = clear_t<List>>
+        namespace detail {
+
+            template<concepts::TypeList List, template<typename T> typename Predicate, bool Erase>
+            struct filter_tlist;
+
+            template<template<typename...> typename XList, typename... Ts, template<typename T> typename Predicate, bool Erase>
+            struct filter_tlist<XList<Ts...>, Predicate, Erase>
+            {
+                using type = join_t<XList<>, std::conditional_t<bool(Predicate<Ts>::value) == Erase, XList<>, XList<Ts>>...>;
+            };
+
+            template<concepts::ValueList List, template<auto V> typename Predicate, bool Erase>
+            struct filter_vlist;
+
+            template<template<typename X, X...> typename XList, typename T, T... Vs, template<auto V> typename Predicate, bool Erase>
+            struct filter_vlist<XList<T, Vs...>, Predicate, Erase>
+            {
+                using type = join_t<XList<T>, std::conditional_t<bool(Predicate<Vs>::value) == Erase, XList<T>, XList<T, Vs>>...>;
+            };
+
+        }
+
+        template<concepts::TypeList List, template<typename T> typename Predicate>
         struct erase_if_tlist {
-            using type = Result;
-        };
-
-        template<concepts::TypeList List, template<typename T> typename Predicate, concepts::TypeList Result>
-        requires (size_v<List> > 0)
-        struct erase_if_tlist<List, Predicate, Result> {
-            using type = typename erase_if_tlist<
-                pop_front_t<List>,
-                Predicate,
-                std::conditional_t<
-                    Predicate<front_tlist_t<List>>::value,
-                    Result,
-                    push_back_tlist_t<Result, front_tlist_t<List>>
-                >
-            >::type;
+            using type = typename detail::filter_tlist<List, Predicate, true>::type;
         };
 
         template<concepts::TypeList List, template<typename T> typename Predicate>
         using erase_if_tlist_t = typename erase_if_tlist<List, Predicate>::type;
 
         template<concepts::TypeList List, template<typename T> typename Predicate>
-        using copy_if_tlist_t = erase_if_tlist_t<List, predicates::negation<Predicate>::template type>;
+        struct copy_if_tlist {
+            using type = typename detail::filter_tlist<List, Predicate, false>::type;
+        };
+
+        template<concepts::TypeList List, template<typename T> typename Predicate>
+        using copy_if_tlist_t = typename copy_if_tlist<List, Predicate>::type;
 
-        template<concepts::ValueList List, template<auto T> typename Predicate, concepts::ValueList Result = clear_t<List>>
+        template<concepts::ValueList List, template<auto V> typename Predicate>
         struct erase_if_vlist {
-            using type = Result;
-        };
-
-        template<concepts::ValueList List, template<auto T> typename Predicate, concepts::ValueList Result>
-        requires (size_v<List> > 0)
-        struct erase_if_vlist<List, Predicate, Result> {
-            using type = typename erase_if_vlist<
-                pop_front_t<List>,
-                Predicate,
-                std::conditional_t<
-                    Predicate<front_vlist_v<List>>::value,
-                    Result,
-                    push_back_vlist_t<Result, front_vlist_v<List>>
-                >
-            >::type;
+            using type = typename detail::filter_vlist<List, Predicate, true>::type;
         };
 
-        template<concepts::TypeList List, template<auto T> typename Predicate>
+        template<concepts::ValueList List, template<auto V> typename Predicate>
         using erase_if_vlist_t = typename erase_if_vlist<List, Predicate>::type;
 
+        template<concepts::ValueList List, template<auto V> typename Predicate>
+        struct copy_if_vlist {
+            using type = typename detail::filter_vlist<List, Predicate, false>::type;
+        };
+
+        template<concepts::ValueList List, template<auto V> typename Predicate>
+        using copy_if_vlist_t = typename copy_if_vlist<List, Predicate>::type;
+
+        //
+        // contains / index_of / find_if
+        // The list is turned into one overload set with a lookup(std::type_identity<T>*) member per element, which is
+        // built once per list. A query is a single overload resolution against that set. If T occurs more than once
+        // the call is ambiguous and index_of falls back to a scan for the first match.
+        // index_of and find_if yield the size of the list if no element matches.
+        // The results derive from std::integral_constant instead of declaring their own static members: those would be
+        // named after the whole list, which is expensive to emit for long lists.
+        //
+
+        namespace detail {
+
+            // index of the first true flag, or the number of flags
+            template<bool... Flags>
+            constexpr size_t find_first()
+            {
+                constexpr bool flags[] = { Flags..., true };
+
+                size_t index = 0;
+                while(!flags[index]) {
+                    ++index;
+                }
+                return index;
+            }
+
+            template<size_t Index, typename T>
+            struct type_index
+            {
+                static std::integral_constant<size_t, Index> lookup(std::type_identity<T>*);
+            };
+
+            template<typename Indices, typename... Ts>
+            struct type_index_set;
+
+            template<size_t... Is, typename... Ts>
+            struct type_index_set<std::index_sequence<Is...>, Ts...> : type_index<Is, Ts>...
+            {
+                using type_index<Is, Ts>::lookup...;
+
+                using size = std::integral_constant<size_t, sizeof...(Ts)>;
+
+                static size lookup(const void*);
+
+                // the builtin does not instantiate a variable per element
+#ifdef META_HAS_IS_SAME
+                template<typename T>
+                using scan = std::integral_constant<size_t, find_first<__is_same(T, Ts)...>()>;
+#else
+                template<typename T>
+                using scan = std::integral_constant<size_t, find_first<std::is_same_v<T, Ts>...>()>;
+#endif
+            };
+
+            template<concepts::TypeList List>
+            struct type_set;
+
+            template<template<typename...> typename XList, typename... Ts>
+            struct type_set<XList<Ts...>>
+            {
+                using type = type_index_set<std::index_sequence_for<Ts...>, Ts...>;
+            };
+
+            struct ambiguous_lookup
+            {
+            };
+
+            template<typename Set, typename T>
+            auto lookup(int) -> decltype(Set::lookup(static_cast<std::type_identity<T>*>(nullptr)));
+
+            template<typename Set, typename T>
+            ambiguous_lookup lookup(...);
+
+            template<typename Set, typename T, typename Result = decltype(detail::lookup<Set, T>(0))>
+            struct index_in_set
+            {
+                using type = Result;
+            };
+
+            template<typename Set, typename T>
+            struct index_in_set<Set, T, ambiguous_lookup>
+            {
+                using type = typename Set::template scan<T>;
+            };
+
+            template<bool... Flags>
+            using first_of = std::integral_constant<size_t, find_first<Flags...>()>;
+
+        }
+
+        template<concepts::TypeList List, typename T>
+        struct index_of_tlist : detail::index_in_set<typename detail::type_set<List>::type, T>::type
+        {
+        };
+
+        template<concepts::TypeList List, typename T>
+        constexpr size_t index_of_tlist_v = index_of_tlist<List, T>::value;
+
+        template<concepts::TypeList List, typename T>
+        struct contains_tlist : std::bool_constant<index_of_tlist<List, T>::value != detail::type_set<List>::type::size::value>
+        {
+        };
+
+        template<concepts::TypeList List, typename T>
+        constexpr bool contains_tlist_v = contains_tlist<List, T>::value;
+
+        template<concepts::TypeList List, template<typename T> typename Predicate>
+        struct find_if_tlist;
+
+        template<template<typename...> typename XList, typename... Ts, template<typename T> typename Predicate>
+        struct find_if_tlist<XList<Ts...>, Predicate> : detail::first_of<bool(Predicate<Ts>::value)...>
+        {
+        };
+
+        template<concepts::TypeList List, template<typename T> typename Predicate>
+        constexpr size_t find_if_tlist_v = find_if_tlist<List, Predicate>::value;
+
+        //
+        // sort
+        // Type lists: bottom-up merge sort on cons lists. A merge step only looks at the heads of its two runs, so every
+        // step is a state with a handful of template arguments, whatever the length of the list. Indexing into a pack
+        // instead costs time linear in its length without the pack indexing builtin (GCC has none).
+        // The steps are run in blocks of eight, nested, so the template depth is logarithmic in the number of steps.
+        // A merge prepends to its result, so the runs alternate between ascending and descending from one pass to the
+        // next, and so does the order of the list of runs. Either way the merge knows which of its runs came first in
+        // the input, which keeps the sort stable with a single comparison per element taken.
+        // Value lists are sorted as a constexpr std::array, see sorted_runs and array_vlist below.
+        //
+
+        namespace detail {
+
+            template<typename Head, typename Tail>
+            struct cons
+            {
+            };
+
+            struct cons_end
+            {
+            };
+
+            // select< Condition >::type< Then, Else >, without a class instantiation per use
+            template<bool Condition>
+            struct select
+            {
+                template<typename Then, typename Else>
+                using type = Then;
+            };
+
+            template<>
+            struct select<false>
+            {
+                template<typename Then, typename Else>
+                using type = Else;
+            };
+
+            // Order::before< A, B >, true if A goes strictly before B
+            template<template<typename A, typename B> typename Compare>
+            struct type_order
+            {
+                template<typename A, typename B>
+                using before = Compare<A, B>;
+            };
+
+            // merge two ascending runs into a descending one, or two descending runs into an ascending one
+            // Lhs holds the elements that came first in the input, it wins ties when ascending and loses them otherwise
+            template<typename Order, bool Ascending, typename Lhs, typename Rhs, typename Result>
+            struct merge_step;
+
+            template<typename Order, bool Ascending, typename L, typename Ls, typename R, typename Rs, typename Result>
+            struct merge_step<Order, Ascending, cons<L, Ls>, cons<R, Rs>, Result>
+            {
+                using next = typename select<Order::template before<R, L>::value == Ascending>::template type<
+                    merge_step<Order, Ascending, cons<L, Ls>, Rs, cons<R, Result>>,
+                    merge_step<Order, Ascending, Ls, cons<R, Rs>, cons<L, Result>>
+                >;
+            };
+
+            template<typename Order, bool Ascending, typename L, typename Ls, typename Result>
+            struct merge_step<Order, Ascending, cons<L, Ls>, cons_end, Result>
+            {
+                using next = merge_step<Order, Ascending, Ls, cons_end, cons<L, Result>>;
+            };
+
+            template<typename Order, bool Ascending, typename R, typename Rs, typename Result>
+            struct merge_step<Order, Ascending, cons_end, cons<R, Rs>, Result>
+            {
+                using next = merge_step<Order, Ascending, cons_end, Rs, cons<R, Result>>;
+            };
+
+            template<typename Order, bool Ascending, typename Result>
+            struct merge_step<Order, Ascending, cons_end, cons_end, Result>
+            {
+                using next = iteration_done<Result>;
+            };
+
+            // one pass merges the runs pairwise, a run without partner is merged with an empty run to flip it as well
+            // ascending runs are listed last to first, descending ones first to last
+            template<typename Order, bool Ascending, size_t RunSize, typename Runs, typename Result>
+            struct merge_pass_step;
+
+            template<typename Order, bool Ascending, size_t RunSize, typename L, typename R, typename Runs, typename Result>
+            struct merge_pass_step<Order, Ascending, RunSize, cons<L, cons<R, Runs>>, Result>
+            {
+                using next = merge_pass_step<
+                    Order, Ascending, RunSize, Runs,
+                    cons<
+                        iterate_t<
+                            std::conditional_t<
+                                Ascending,
+                                merge_step<Order, Ascending, R, L, cons_end>,
+                                merge_step<Order, Ascending, L, R, cons_end>
+                            >,
+                            2 * RunSize
+                        >,
+                        Result
+                    >
+                >;
+            };
+
+            template<typename Order, bool Ascending, size_t RunSize, typename L, typename Result>
+            struct merge_pass_step<Order, Ascending, RunSize, cons<L, cons_end>, Result>
+            {
+                using next = merge_pass_step<
+                    Order, Ascending, RunSize, cons_end,
+                    cons<iterate_t<merge_step<Order, Ascending, L, cons_end, cons_end>, RunSize>, Result>
+                >;
+            };
+
+            template<typename Order, bool Ascending, size_t RunSize, typename Result>
+            struct merge_pass_step<Order, Ascending, RunSize, cons_end, Result>
+            {
+                using next = iteration_done<Result>;
+            };
+
+            // the passes, until a single run is left
+            template<typename Run, bool Ascending>
+            struct sorted_run
+            {
+            };
+
+            template<typename Order, bool Ascending, size_t RunSize, size_t Size, typename Runs>
+            struct merge_passes
+            {
+                using type = typename merge_passes<
+                    Order, !Ascending, 2 * RunSize, Size,
+                    iterate_t<merge_pass_step<Order, Ascending, RunSize, Runs, cons_end>, Size / RunSize / 2 + 1>
+                >::type;
+            };
+
+            template<typename Order, bool Ascending, size_t RunSize, size_t Size, typename Run>
+            struct merge_passes<Order, Ascending, RunSize, Size, cons<Run, cons_end>>
+            {
+                using type = sorted_run<Run, Ascending>;
+            };
+
+            template<typename Order, bool Ascending, size_t RunSize, size_t Size>
+            struct merge_passes<Order, Ascending, RunSize, Size, cons_end>
+            {
+                using type = sorted_run<cons_end, Ascending>;
+            };
+
+            template<typename... Elements>
+            struct element_pack
+            {
+            };
+
+            // element_pack -> list of single element runs, last to first, eight elements per step
+            template<typename Elements, typename Result>
+            struct single_runs_step;
+
+            template<typename E0, typename E1, typename E2, typename E3, typename E4, typename E5, typename E6, typename E7, typename... Es, typename Result>
+            struct single_runs_step<element_pack<E0, E1, E2, E3, E4, E5, E6, E7, Es...>, Result>
+            {
+                using next = single_runs_step<
+                    element_pack<Es...>,
+                    cons<cons<E7, cons_end>, cons<cons<E6, cons_end>, cons<cons<E5, cons_end>, cons<cons<E4, cons_end>,
+                    cons<cons<E3, cons_end>, cons<cons<E2, cons_end>, cons<cons<E1, cons_end>, cons<cons<E0, cons_end>,
+                    Result>>>>>>>>
+                >;
+            };
+
+            template<typename E0, typename... Es, typename Result>
+            struct single_runs_step<element_pack<E0, Es...>, Result>
+            {
+                using next = single_runs_step<element_pack<Es...>, cons<cons<E0, cons_end>, Result>>;
+            };
+
+            template<typename Result>
+            struct single_runs_step<element_pack<>, Result>
+            {
+                using next = iteration_done<Result>;
+            };
+
+            // sorted run -> element_pack, eight elements per step
+            template<typename Run, bool Ascending, typename Result>
+            struct run_elements_step;
+
+            template<typename E0, typename E1, typename E2, typename E3, typename E4, typename E5, typename E6, typename E7, typename Run, bool Ascending, typename... Result>
+            struct run_elements_step<cons<E0, cons<E1, cons<E2, cons<E3, cons<E4, cons<E5, cons<E6, cons<E7, Run>>>>>>>>, Ascending, element_pack<Result...>>
+            {
+                using next = run_elements_step<
+                    Run, Ascending,
+                    std::conditional_t<
+                        Ascending,
+                        element_pack<Result..., E0, E1, E2, E3, E4, E5, E6, E7>,
+                        element_pack<E7, E6, E5, E4, E3, E2, E1, E0, Result...>
+                    >
+                >;
+            };
+
+            template<typename E0, typename Run, bool Ascending, typename... Result>
+            struct run_elements_step<cons<E0, Run>, Ascending, element_pack<Result...>>
+            {
+                using next = run_elements_step<
+                    Run, Ascending,
+                    std::conditional_t<Ascending, element_pack<Result..., E0>, element_pack<E0, Result...>>
+                >;
+            };
+
+            template<bool Ascending, typename Result>
+            struct run_elements_step<cons_end, Ascending, Result>
+            {
+                using next = iteration_done<Result>;
+            };
+
+            template<typename SortedRun, size_t Size>
+            struct sorted_elements;
+
+            template<typename Run, bool Ascending, size_t Size>
+            struct sorted_elements<sorted_run<Run, Ascending>, Size>
+            {
+                using type = iterate_t<run_elements_step<Run, Ascending, element_pack<>>, Size / 8 + 8>;
+            };
+
+            template<typename Order, typename... Ts>
+            struct sort_elements
+            {
+                using type = typename sorted_elements<
+                    typename merge_passes<
+                        Order, true, 1, sizeof...(Ts),
+                        iterate_t<single_runs_step<element_pack<Ts...>, cons_end>, sizeof...(Ts) / 8 + 8>
+                    >::type,
+                    sizeof...(Ts)
+                >::type;
+            };
+
+            template<typename List, typename Elements>
+            struct unwrap_sorted;
+
+            template<template<typename...> typename XList, typename... Es>
+            struct unwrap_sorted<XList<>, element_pack<Es...>>
+            {
+                using type = XList<Es...>;
+            };
+
+            // stable_sorted( values, compare )
+            // the whole bottom-up merge sort in one constant evaluation, ping-ponging between two buffers, for the
+            // internal sorts of the set algorithms below
+            template<typename T, size_t Size, typename Compare>
+            constexpr std::array<T, Size> stable_sorted(std::array<T, Size> values, Compare compare)
+            {
+                std::array<T, Size> buffer{};
+                T* from = values.data();
+                T* to   = buffer.data();
+                for(size_t width = 1; width < Size; width *= 2) {
+                    for(size_t low = 0; low < Size; low += 2 * width) {
+                        const size_t middle = std::min(low + width, Size);
+                        const size_t high   = std::min(low + 2 * width, Size);
+                        size_t left = low, right = middle, out = low;
+                        while(left < middle && right < high) {
+                            if(compare(from[right], from[left])) {
+                                to[out++] = from[right++];
+                            } else {
+                                to[out++] = from[left++];
+                            }
+                        }
+                        while(left < middle) {
+                            to[out++] = from[left++];
+                        }
+                        while(right < high) {
+                            to[out++] = from[right++];
+                        }
+                    }
+                    std::swap(from, to);
+                }
+                if(from != values.data()) {
+                    values = buffer;
+                }
+                return values;
+            }
+
+            // merged_runs( values, width, compare )
+            // one pass of the bottom-up merge sort, merges the runs of length width pairwise
+            template<typename T, size_t Size, typename Compare>
+            constexpr std::array<T, Size> merged_runs(const std::array<T, Size>& values, size_t width, Compare compare)
+            {
+                std::array<T, Size> result{};
+                const T* from = values.data();
+                T* to         = result.data();
+                for(size_t low = 0; low < Size; low += 2 * width) {
+                    const size_t middle = std::min(low + width, Size);
+                    const size_t high   = std::min(low + 2 * width, Size);
+                    size_t left = low, right = middle, out = low;
+                    while(left < middle && right < high) {
+                        if(compare(from[right], from[left])) {
+                            to[out++] = from[right++];
+                        } else {
+                            to[out++] = from[left++];
+                        }
+                    }
+                    while(left < middle) {
+                        to[out++] = from[left++];
+                    }
+                    while(right < high) {
+                        to[out++] = from[right++];
+                    }
+                }
+                return result;
+            }
+
+            // std::less<> costs several times the constexpr operations of a plain operator<
+            struct less_than
+            {
+                template<typename T>
+                constexpr bool operator()(const T& lhs, const T& rhs) const
+                {
+                    return lhs < rhs;
+                }
+            };
+
+            template<typename Compare>
+            struct plain_compare
+            {
+                using type = Compare;
+            };
+
+            template<>
+            struct plain_compare<std::less<>>
+            {
+                using type = less_than;
+            };
+
+            // sorted_runs< Values, Compare, Width >
+            // Values sorted into runs of length Width. Every pass is a constant evaluation of its own, GCC limits the
+            // number of operations per evaluation (-fconstexpr-ops-limit), which a single call sorting tens of
+            // thousands of values exceeds.
+            template<const auto& Values, typename Compare, size_t Width>
+            inline constexpr auto sorted_runs = merged_runs(sorted_runs<Values, Compare, Width / 2>, Width / 2, Compare{});
+
+            template<const auto& Values, typename Compare>
+            inline constexpr auto sorted_runs<Values, Compare, 1> = Values;
+
+            template<const auto& Values, typename Compare>
+            inline constexpr const auto& sorted_array =
+                sorted_runs<Values, typename plain_compare<Compare>::type, std::bit_ceil(Values.size())>;
+
+            template<typename T, typename Compare, T... Vs>
+            inline constexpr const auto& sorted_values = sorted_array<value_array<T, Vs...>::values, Compare>;
+
+            // array_vlist< XList, Values >
+            // XList<T, Values[0], ...> for a constexpr std::array. Reading a large constant back element by element is
+            // quadratic in GCC, so it is cut into chunks that become template arguments of their own, and the chunk lists
+            // are joined.
+            static constexpr size_t array_chunk_size = 64;
+
+            template<size_t ChunkSize, typename T, size_t Size>
+            constexpr std::array<T, ChunkSize> array_chunk(const std::array<T, Size>& values, size_t first)
+            {
+                std::array<T, ChunkSize> chunk{};
+                for(size_t i = 0; i < ChunkSize; ++i) {
+                    chunk[i] = values[first + i];
+                }
+                return chunk;
+            }
+
+            template<template<typename X, X...> typename XList, typename T, auto Chunk, size_t... Is>
+            XList<T, Chunk[Is]...> chunk_vlist(std::index_sequence<Is...>);
+
+            template<
+                template<typename X, X...> typename XList, const auto& Values,
+                typename Chunks = std::make_index_sequence<Values.size() / array_chunk_size>,
+                typename Rest = std::make_index_sequence<Values.size() % array_chunk_size>
+            >
+            struct array_vlist;
+
+            template<template<typename X, X...> typename XList, const auto& Values, size_t... Ks, size_t... Rs>
+            struct array_vlist<XList, Values, std::index_sequence<Ks...>, std::index_sequence<Rs...>>
+            {
+                using value_type = typename std::remove_cvref_t<decltype(Values)>::value_type;
+
+                using type = join_t<
+                    XList<value_type>,
+                    decltype(
+                        chunk_vlist<XList, value_type, array_chunk<array_chunk_size>(Values, Ks * array_chunk_size)>(
+                            std::make_index_sequence<array_chunk_size>()
+                        )
+                    )...,
+                    decltype(
+                        chunk_vlist<XList, value_type, array_chunk<sizeof...(Rs)>(Values, sizeof...(Ks) * array_chunk_size)>(
+                            std::index_sequence<Rs...>()
+                        )
+                    )
+                >;
+            };
+
+        }
+
+        template<concepts::TypeList List, template<typename A, typename B> typename Compare>
+        struct sort_tlist;
+
+        template<template<typename...> typename XList, typename... Ts, template<typename A, typename B> typename Compare>
+        struct sort_tlist<XList<Ts...>, Compare>
+        {
+            using type = typename detail::unwrap_sorted<
+                XList<>,
+                typename detail::sort_elements<detail::type_order<Compare>, Ts...>::type
+            >::type;
+        };
+
+        template<concepts::TypeList List, template<typename A, typename B> typename Compare>
+        using sort_tlist_t = typename sort_tlist<List, Compare>::type;
+
+        template<concepts::AnyValueList List, typename Compare>
+        struct sort_vlist;
+
+        template<template<typename X, X...> typename XList, typename T, T... Vs, typename Compare>
+        struct sort_vlist<XList<T, Vs...>, Compare>
+        {
+            using type = typename detail::array_vlist<XList, detail::sorted_values<T, Compare, Vs...>>::type;
+        };
+
+        template<concepts::AnyValueList List, typename Compare = std::less<>>
+        using sort_vlist_t = typename sort_vlist<List, Compare>::type;
+
+        //
+        // unique / set_union / set_intersection / set_difference / is_subset
+        // Results keep the order of the first occurrences, union appends the new elements of the right list to the left.
+        // The lists may be of different list templates, value lists of the same value type, results take the template
+        // of the left list.
+        // Type lists test membership against the overload set of contains / index_of, which is built once per list. An
+        // ambiguous lookup is a hit as well, only unique resolves it to the first index, once per repeated type.
+        // Value lists run as one constexpr array algorithm on operator<: sorting the indices by value finds the first
+        // occurrences, binary search in the sorted right list answers membership.
+        //
+
+        namespace detail {
+
+            template<typename Set, typename T, typename Result = decltype(detail::lookup<Set, T>(0))>
+            struct in_set : std::true_type
+            {
+            };
+
+            template<typename Set, typename T>
+            struct in_set<Set, T, typename Set::size> : std::false_type
+            {
+            };
+
+            template<typename List, typename Indices>
+            struct unique_tlist;
+
+            template<template<typename...> typename XList, typename... Ts, size_t... Is>
+            struct unique_tlist<XList<Ts...>, std::index_sequence<Is...>>
+            {
+                using set = typename type_set<XList<Ts...>>::type;
+
+                using type = join_t<
+                    XList<>, std::conditional_t<index_in_set<set, Ts>::type::value == Is, XList<Ts>, XList<>>...
+                >;
+            };
+
+            // the elements of List in the list template of Empty
+            template<typename List, typename Empty>
+            struct rebind_tlist;
+
+            template<template<typename...> typename XList, typename... Ts, template<typename...> typename YList>
+            struct rebind_tlist<XList<Ts...>, YList<>>
+            {
+                using type = YList<Ts...>;
+            };
+
+            template<typename List, typename Set, bool Keep>
+            struct filter_in_set;
+
+            template<template<typename...> typename XList, typename... Ts, typename Set, bool Keep>
+            struct filter_in_set<XList<Ts...>, Set, Keep>
+            {
+                using type = join_t<XList<>, std::conditional_t<in_set<Set, Ts>::value == Keep, XList<Ts>, XList<>>...>;
+            };
+
+            template<typename List, typename Set>
+            struct all_in_set;
+
+            template<template<typename...> typename XList, typename... Ts, typename Set>
+            struct all_in_set<XList<Ts...>, Set> : std::bool_constant<find_first<!in_set<Set, Ts>::value...>() == sizeof...(Ts)>
+            {
+            };
+
+        }
+
+        template<concepts::TypeList List>
+        struct unique_tlist
+        {
+            using type = typename detail::unique_tlist<List, std::make_index_sequence<size_v<List>>>::type;
+        };
+
+        template<concepts::TypeList List>
+        using unique_tlist_t = typename unique_tlist<List>::type;
+
+        template<concepts::TypeList Lhs, concepts::TypeList Rhs>
+        struct set_union_tlist
+        {
+            using type = detail::join_t<
+                clear_t<Lhs>,
+                unique_tlist_t<Lhs>,
+                typename detail::filter_in_set<
+                    unique_tlist_t<typename detail::rebind_tlist<Rhs, clear_t<Lhs>>::type>, typename detail::type_set<Lhs>::type, false
+                >::type
+            >;
+        };
+
+        template<concepts::TypeList Lhs, concepts::TypeList Rhs>
+        using set_union_tlist_t = typename set_union_tlist<Lhs, Rhs>::type;
+
+        template<concepts::TypeList Lhs, concepts::TypeList Rhs>
+        struct set_intersection_tlist
+        {
+            using type = typename detail::filter_in_set<unique_tlist_t<Lhs>, typename detail::type_set<Rhs>::type, true>::type;
+        };
+
+        template<concepts::TypeList Lhs, concepts::TypeList Rhs>
+        using set_intersection_tlist_t = typename set_intersection_tlist<Lhs, Rhs>::type;
+
+        template<concepts::TypeList Lhs, concepts::TypeList Rhs>
+        struct set_difference_tlist
+        {
+            using type = typename detail::filter_in_set<unique_tlist_t<Lhs>, typename detail::type_set<Rhs>::type, false>::type;
+        };
+
+        template<concepts::TypeList Lhs, concepts::TypeList Rhs>
+        using set_difference_tlist_t = typename set_difference_tlist<Lhs, Rhs>::type;
+
+        template<concepts::TypeList Lhs, concepts::TypeList Rhs>
+        struct is_subset_tlist : detail::all_in_set<Lhs, typename detail::type_set<Rhs>::type>
+        {
+        };
+
+        namespace detail {
+
+            enum class set_operation { unite, intersect, subtract };
+
+            template<typename T, size_t Capacity>
+            struct value_set_result
+            {
+                std::array<T, Capacity> values{};
+                size_t size = 0;
+            };
+
+            template<typename T>
+            constexpr bool contains_sorted(const T* values, size_t size, const T& value)
+            {
+                size_t low = 0, high = size;
+                while(low < high) {
+                    const size_t middle = low + (high - low) / 2;
+                    if(values[middle] < value) {
+                        low = middle + 1;
+                    } else {
+                        high = middle;
+                    }
+                }
+                return low < size && !(value < values[low]);
+            }
+
+            // unite: first occurrences in lhs followed by rhs
+            // intersect / subtract: first occurrences in lhs that are / are not in rhs
+            template<set_operation Operation, typename T, size_t LhsSize, size_t RhsSize>
+            constexpr auto combine_values(const std::array<T, LhsSize>& lhs, const std::array<T, RhsSize>& rhs)
+            {
+                constexpr size_t count = Operation == set_operation::unite ? LhsSize + RhsSize : LhsSize;
+
+                std::array<T, count> values{};
+                for(size_t i = 0; i < LhsSize; ++i) {
+                    values[i] = lhs[i];
+                }
+                if constexpr(Operation == set_operation::unite) {
+                    for(size_t i = 0; i < RhsSize; ++i) {
+                        values[LhsSize + i] = rhs[i];
+                    }
+                }
+
+                // the stable sort keeps equal values in input order, so the first of each run is the first occurrence
+                std::array<size_t, count> order{};
+                for(size_t i = 0; i < count; ++i) {
+                    order[i] = i;
+                }
+                const T* const data = values.data();
+                order = stable_sorted(order, [data](size_t a, size_t b) { return data[a] < data[b]; });
+
+                std::array<bool, count> keep{};
+                for(size_t i = 0; i < count; ++i) {
+                    keep[order[i]] = i == 0 || data[order[i - 1]] < data[order[i]];
+                }
+
+                if constexpr(Operation != set_operation::unite) {
+                    const std::array<T, RhsSize> sorted_rhs = stable_sorted(rhs, [](const T& a, const T& b) { return a < b; });
+                    for(size_t i = 0; i < count; ++i) {
+                        if(keep[i]) {
+                            keep[i] = contains_sorted(sorted_rhs.data(), RhsSize, data[i]) == (Operation == set_operation::intersect);
+                        }
+                    }
+                }
+
+                value_set_result<T, count> result;
+                for(size_t i = 0; i < count; ++i) {
+                    if(keep[i]) {
+                        result.values[result.size++] = values[i];
+                    }
+                }
+                return result;
+            }
+
+            template<set_operation Operation, typename Lhs, typename Rhs>
+            inline constexpr auto combined_values = 0;
+
+            template<
+                set_operation Operation, template<typename X, X...> typename XList, typename T, T... Ls,
+                template<typename X, X...> typename YList, T... Rs
+            >
+            inline constexpr auto combined_values<Operation, XList<T, Ls...>, YList<T, Rs...>> =
+                combine_values<Operation>(value_array<T, Ls...>::values, value_array<T, Rs...>::values);
+
+            template<const auto& Result>
+            inline constexpr auto trimmed_values = [] {
+                std::array<typename std::remove_cvref_t<decltype(Result.values)>::value_type, Result.size> values{};
+                for(size_t i = 0; i < Result.size; ++i) {
+                    values[i] = Result.values[i];
+                }
+                return values;
+            }();
+
+            template<set_operation Operation, typename Lhs, typename Rhs>
+            struct combine_vlist;
+
+            template<set_operation Operation, template<typename X, X...> typename XList, typename T, T... Ls, typename Rhs>
+            struct combine_vlist<Operation, XList<T, Ls...>, Rhs>
+            {
+                using type = typename array_vlist<
+                    XList, trimmed_values<combined_values<Operation, XList<T, Ls...>, Rhs>>
+                >::type;
+            };
+
+        }
+
+        template<concepts::ValueList List>
+        struct unique_vlist
+        {
+            using type = typename detail::combine_vlist<detail::set_operation::unite, List, clear_t<List>>::type;
+        };
+
+        template<concepts::ValueList List>
+        using unique_vlist_t = typename unique_vlist<List>::type;
+
+        template<concepts::ValueList Lhs, concepts::ValueList Rhs>
+        requires std::is_same_v<value_type_t<Lhs>, value_type_t<Rhs>>
+        struct set_union_vlist
+        {
+            using type = typename detail::combine_vlist<detail::set_operation::unite, Lhs, Rhs>::type;
+        };
+
+        template<concepts::ValueList Lhs, concepts::ValueList Rhs>
+        using set_union_vlist_t = typename set_union_vlist<Lhs, Rhs>::type;
+
+        template<concepts::ValueList Lhs, concepts::ValueList Rhs>
+        requires std::is_same_v<value_type_t<Lhs>, value_type_t<Rhs>>
+        struct set_intersection_vlist
+        {
+            using type = typename detail::combine_vlist<detail::set_operation::intersect, Lhs, Rhs>::type;
+        };
+
+        template<concepts::ValueList Lhs, concepts::ValueList Rhs>
+        using set_intersection_vlist_t = typename set_intersection_vlist<Lhs, Rhs>::type;
+
+        template<concepts::ValueList Lhs, concepts::ValueList Rhs>
+        requires std::is_same_v<value_type_t<Lhs>, value_type_t<Rhs>>
+        struct set_difference_vlist
+        {
+            using type = typename detail::combine_vlist<detail::set_operation::subtract, Lhs, Rhs>::type;
+        };
+
+        template<concepts::ValueList Lhs, concepts::ValueList Rhs>
+        using set_difference_vlist_t = typename set_difference_vlist<Lhs, Rhs>::type;
+
+        template<concepts::ValueList Lhs, concepts::ValueList Rhs>
+        requires std::is_same_v<value_type_t<Lhs>, value_type_t<Rhs>>
+        struct is_subset_vlist : std::bool_constant<detail::combined_values<detail::set_operation::subtract, Lhs, Rhs>.size == 0>
+        {
+        };
+
 
         /* iterator concept */
 
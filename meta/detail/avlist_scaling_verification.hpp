@@ -0,0 +1,101 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "../avlist.hpp"
+#include "../vlist.hpp"
+#include "../lookup.hpp"
+#include <array>
+#include <cstdint>
+
+//
+// avlist scaling verification
+// A table the size of the lookup tables avlist is meant for, in a translation unit of its own like the other scaling
+// verifications. Every algorithm runs on the whole table, sort is past what fits into a single constant evaluation.
+//
+
+namespace meta::verification::avlist_scaling {
+
+    static constexpr size_t table_size = 65536;
+
+    constexpr std::uint32_t crc32_of(std::uint32_t value)
+    {
+        for(int bit = 0; bit < 16; ++bit) {
+            value = (value & 1) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+        }
+        return value;
+    }
+
+    constexpr std::array<std::uint32_t, table_size> make_table()
+    {
+        std::array<std::uint32_t, table_size> table{};
+        for(std::uint32_t i = 0; i < table_size; ++i) {
+            table[i] = crc32_of(i);
+        }
+        return table;
+    }
+
+    inline constexpr std::array<std::uint32_t, table_size> crc_table = make_table();
+
+    using table = avlist<crc_table>;
+
+    static_assert(
+        table::size == table_size &&
+        table::get<0> == 0 &&
+        table::get<12345> == crc32_of(12345) &&
+        table::back<> == crc32_of(table_size - 1)
+    );
+
+    struct low_byte
+    {
+        constexpr std::uint8_t operator()(std::uint32_t value) const
+        {
+            return static_cast<std::uint8_t>(value);
+        }
+    };
+
+    struct is_odd
+    {
+        constexpr bool operator()(std::uint32_t value) const
+        {
+            return value & 1;
+        }
+    };
+
+    template<typename List>
+    constexpr bool is_sorted()
+    {
+        const auto* values = List::values.data();
+        for(size_t i = 1; i < List::size; ++i) {
+            if(values[i] < values[i - 1]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(
+        table::transform<low_byte>::get<54321> == static_cast<std::uint8_t>(crc32_of(54321)) &&
+        table::copy_if<is_odd>::size + table::erase_if<is_odd>::size == table_size &&
+        table::sort<>::size == table_size &&
+        is_sorted<table::sort<>>()
+    );
+
+    static_assert(
+        value_list::size<table::copy_if<is_odd>::to_vlist<>> == table::copy_if<is_odd>::size &&
+        value_list::front<table::to_vlist<>> == 0 &&
+        array_value_list::from_vlist<table::to_vlist<>>::back<> == table::back<>
+    );
+
+    // crc32_of is a bijection, so the table holds distinct keys and crc32_of(table_size) is none of them. They spread
+    // over 32 bits and are more than the perfect hash is built for.
+    static_assert(
+        detail::value_lookup<table>::strategy == detail::lookup_strategy::binary_search &&
+        value_list::lookup<table>(0) == 0 &&
+        value_list::lookup<table>(crc32_of(12345)) == 12345 &&
+        value_list::lookup<table>(crc32_of(table_size - 1)) == table_size - 1 &&
+        value_list::lookup<table>(crc32_of(table_size)) == table_size
+    );
+
+}
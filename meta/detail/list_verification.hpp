@@ -7,6 +7,14 @@
 #include "../vlist.hpp"
 #include "../common.hpp"
 #include "../util.hpp"
+#include "../type_map.hpp"
+#include "../avlist.hpp"
+#include "../dispatch.hpp"
+#include "../lookup.hpp"
+#include "../keyword.hpp"
+#include <climits>
+#include <cstdint>
+#include <string_view>
 #include <type_traits>
 
 namespace meta::verification {
@@ -107,14 +115,14 @@ namespace meta::verification {
     static_assert(
         are_same_v<
             type_list::front<tlist<int,float>>,
-            tlist<int,float>::front,
+            tlist<int,float>::front<>,
             int
         >
     );
 
     static_assert(
         value_list::front<vlist<int, 1, 2>> == 1 &&
-        vlist<int, 1, 2>::front == 1
+        vlist<int, 1, 2>::front<> == 1
     );
 
     //
@@ -124,14 +132,14 @@ namespace meta::verification {
     static_assert(
         are_same_v<
             type_list::back<tlist<int,float>>,
-            tlist<int,float>::back,
+            tlist<int,float>::back<>,
             float
         >
     );
 
     static_assert(
         value_list::back<vlist<int, 1, 2>> == 2 &&
-        vlist<int, 1, 2>::back == 2
+        vlist<int, 1, 2>::back<> == 2
     );
 
     //
@@ -206,6 +214,46 @@ namespace meta::verification {
         >
     );
 
+    //
+    // pop_front
+    //
+
+    static_assert(
+        are_same_v<
+            type_list::pop_front<tlist<int, float>>,
+            tlist<int, float>::pop_front<>,
+            tlist<float>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::pop_front<vlist<int, 1, 2>>,
+            vlist<int, 1, 2>::pop_front<>,
+            vlist<int, 2>
+        >
+    );
+
+    //
+    // pop_back
+    //
+
+    static_assert(
+        are_same_v<
+            type_list::pop_back<tlist<int, float>>,
+            tlist<int, float>::pop_back<>,
+            tlist<int>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::pop_back<vlist<int, 1, 2>>,
+            vlist<int, 1, 2>::pop_back<>,
+            vlist<int, 1>
+        >
+    );
+
     //
     // concat
     //
@@ -274,6 +322,48 @@ namespace meta::verification {
         >
     );
 
+    static_assert(
+        are_same_v<
+            type_list::concat<tlist<int>, tlist<>, tlist<float, short>, tlist<double>>,
+            tlist<int>::concat<tlist<>, tlist<float, short>, tlist<double>>,
+            tlist<int, float, short, double>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            type_list::concat<custom_tlist<int>>,
+            custom_tlist<int>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::concat<vlist<int, 1>, vlist<int>, vlist<int, 2, 3>, vlist<int, 4>, vlist<int, 5>>,
+            vlist<int, 1>::concat<vlist<int>, vlist<int, 2, 3>, vlist<int, 4>, vlist<int, 5>>,
+            vlist<int, 1, 2, 3, 4, 5>
+        >
+    );
+
+    //
+    // flatten
+    //
+
+    static_assert(
+        are_same_v<
+            type_list::flatten<tlist<>>,
+            tlist<>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            type_list::flatten<tlist<int, tlist<float, custom_tlist<short>>, tlist<>, char>>,
+            tlist<int, tlist<float, custom_tlist<short>>, tlist<>, char>::flatten<>,
+            tlist<int, float, short, tlist<>, char>
+        >
+    );
+
     //
     // reverse
     //
@@ -281,7 +371,7 @@ namespace meta::verification {
     static_assert(
         are_same_v<
             type_list::reverse<tlist<>>,
-            tlist<>::reverse,
+            tlist<>::reverse<>,
             tlist<>
         >
     );
@@ -289,7 +379,7 @@ namespace meta::verification {
     static_assert(
         are_same_v<
             type_list::reverse<tlist<int>>,
-            tlist<int>::reverse,
+            tlist<int>::reverse<>,
             tlist<int>
         >
     );
@@ -297,7 +387,7 @@ namespace meta::verification {
     static_assert(
         are_same_v<
             type_list::reverse<tlist<int, float, short>>,
-            tlist<int, float, short>::reverse,
+            tlist<int, float, short>::reverse<>,
             tlist<short, float, int>
         >
     );
@@ -305,7 +395,7 @@ namespace meta::verification {
     static_assert(
         are_same_v<
             value_list::reverse<vlist<int>>,
-            vlist<int>::reverse,
+            vlist<int>::reverse<>,
             vlist<int>
         >
     );
@@ -313,7 +403,7 @@ namespace meta::verification {
     static_assert(
         are_same_v<
             value_list::reverse<vlist<int, 1>>,
-            vlist<int, 1>::reverse,
+            vlist<int, 1>::reverse<>,
             vlist<int, 1>
         >
     );
@@ -321,7 +411,7 @@ namespace meta::verification {
     static_assert(
         are_same_v<
             value_list::reverse<vlist<int, 1, 2, 3>>,
-            vlist<int, 1, 2, 3>::reverse,
+            vlist<int, 1, 2, 3>::reverse<>,
             vlist<int, 3, 2, 1>
         >
     );
@@ -456,6 +546,95 @@ namespace meta::verification {
         >
     );
 
+    static_assert(
+        are_same_v<
+            value_list::set<vlist<int, 1, 2, 3>, 2, 42>,
+            vlist<int, 1, 2, 3>::set<2, 42>,
+            vlist<int, 1, 2, 42>
+        >
+    );
+
+    // an index past the end is an error, not the list unchanged
+    template<typename List, size_t Where>
+    concept settable_at = requires { typename common::set_tlist<List, Where, float>::type; };
+
+    template<typename List, size_t Where>
+    concept value_settable_at = requires { typename common::set_vlist<List, Where, 42>::type; };
+
+    static_assert(
+        settable_at<tlist<int, short>, 1> && !settable_at<tlist<int, short>, 2> && !settable_at<tlist<>, 0> &&
+        value_settable_at<vlist<int, 1, 2>, 1> && !value_settable_at<vlist<int, 1, 2>, 2>
+    );
+
+    //
+    // to_array
+    //
+
+    static_assert(
+        value_list::to_array<vlist<int, 3, 1, 2>> == std::array<int, 3>{ 3, 1, 2 } &&
+        value_list::to_array<vlist<char>>.empty() &&
+        vlist<int, 3, 1, 2>::to_array<>[1] == 1
+    );
+
+    // one object per value type and sequence of values
+    static_assert(
+        &value_list::to_array<vlist<int, 3, 1, 2>> == &value_list::to_array<custom_vlist<int, 3, 1, 2>> &&
+        &value_list::to_array<vlist<int, 3, 1, 2>> == &array_value_list::from_vlist<vlist<int, 3, 1, 2>>::values &&
+        static_cast<const void*>(&value_list::to_array<vlist<int, 3, 1, 2>>) !=
+            static_cast<const void*>(&value_list::to_array<vlist<long, 3, 1, 2>>)
+    );
+
+    template<typename T>
+    struct size_of : std::integral_constant<size_t, sizeof(T)> {};
+
+    static_assert(
+        type_list::to_array<tlist<char, short, char>, size_of> == std::array<size_t, 3>{ 1, 2, 1 } &&
+        &tlist<char, short, char>::to_array<size_of> == &value_list::to_array<vlist<size_t, 1, 2, 1>> &&
+        type_list::to_array<custom_tlist<>, size_of, int>.empty()
+    );
+
+    //
+    // split
+    //
+
+    static_assert(
+        are_same_v<typename type_list::split<tlist<int, float, short>, 0>::lhs, tlist<>> &&
+        are_same_v<typename type_list::split<tlist<int, float, short>, 0>::rhs, tlist<int, float, short>>
+    );
+
+    static_assert(
+        are_same_v<typename type_list::split<tlist<int, float, short>, 2>::lhs, tlist<int, float>> &&
+        are_same_v<typename type_list::split<tlist<int, float, short>, 2>::rhs, tlist<short>>
+    );
+
+    static_assert(
+        are_same_v<typename type_list::split<tlist<int, float, short>, 3>::lhs, tlist<int, float, short>> &&
+        are_same_v<typename type_list::split<tlist<int, float, short>, 3>::rhs, tlist<>>
+    );
+
+    static_assert(
+        are_same_v<typename common::split_t<vlist<int, 1, 2, 3>, 1>::lhs, vlist<int, 1>> &&
+        are_same_v<typename common::split_t<vlist<int, 1, 2, 3>, 1>::rhs, vlist<int, 2, 3>>
+    );
+
+    //
+    // insert
+    //
+
+    static_assert(
+        are_same_v<
+            type_list::insert<tlist<int, float>, 1, tlist<short, double>>,
+            tlist<int, short, double, float>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            type_list::insert<custom_tlist<int>, 1, custom_tlist<short>>,
+            custom_tlist<int, short>
+        >
+    );
+
     // erase_if
 
     using meta::predicates::bind_1st;
@@ -469,4 +648,744 @@ namespace meta::verification {
         >
     );
 
-}
\ No newline at end of file
+    static_assert(
+        are_same_v<
+            type_list::erase_if<tlist<>, std::is_integral>,
+            tlist<>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            type_list::erase_if<custom_tlist<int, float, short, double, char>, std::is_integral>,
+            custom_tlist<float, double>
+        >
+    );
+
+    template<auto V>
+    struct is_odd
+    {
+        static constexpr bool value = (V % 2) != 0;
+    };
+
+    static_assert(
+        are_same_v<
+            value_list::erase_if<vlist<int, 1, 2, 3, 4, 5>, is_odd>,
+            vlist<int, 1, 2, 3, 4, 5>::erase_if<is_odd>,
+            vlist<int, 2, 4>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::erase_if<custom_vlist<int>, is_odd>,
+            custom_vlist<int>
+        >
+    );
+
+    // copy_if
+
+    static_assert(
+        are_same_v<
+            type_list::copy_if<tlist<int, float, short, double, char>, std::is_integral>,
+            tlist<int, float, short, double, char>::copy_if<std::is_integral>,
+            tlist<int, short, char>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::copy_if<vlist<int, 1, 2, 3, 4, 5>, is_odd>,
+            vlist<int, 1, 2, 3, 4, 5>::copy_if<is_odd>,
+            vlist<int, 1, 3, 5>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::copy_if<custom_vlist<int, 1, 2, 3>, is_odd>,
+            custom_vlist<int, 1, 3>
+        >
+    );
+
+    //
+    // sort
+    //
+
+    template<typename A, typename B>
+    struct smaller_type : std::bool_constant<(sizeof(A) < sizeof(B))> {};
+
+    static_assert(
+        are_same_v<
+            type_list::sort<tlist<>, smaller_type>,
+            tlist<>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            type_list::sort<tlist<double>, smaller_type>,
+            tlist<double>
+        >
+    );
+
+    // equivalent elements keep their order
+    static_assert(
+        are_same_v<
+            type_list::sort<tlist<double, int, char, float, short, unsigned char, long long, unsigned>, smaller_type>,
+            tlist<double, int, char, float, short, unsigned char, long long, unsigned>::sort<smaller_type>,
+            tlist<char, unsigned char, short, int, float, unsigned, double, long long>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            type_list::sort<custom_tlist<int, char, short>, smaller_type>,
+            custom_tlist<char, short, int>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::sort<vlist<int>>,
+            vlist<int>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::sort<vlist<int, 3, 1, 2, 3, 0, 1>>,
+            vlist<int, 3, 1, 2, 3, 0, 1>::sort<>,
+            vlist<int, 0, 1, 1, 2, 3, 3>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::sort<vlist<int, 3, 1, 2>, std::greater<>>,
+            vlist<int, 3, 2, 1>
+        >
+    );
+
+    struct closer_to_zero
+    {
+        constexpr bool operator()(int a, int b) const
+        {
+            return (a < 0 ? -a : a) < (b < 0 ? -b : b);
+        }
+    };
+
+    static_assert(
+        are_same_v<
+            value_list::sort<custom_vlist<int, 2, -1, 0, 1, -2>, closer_to_zero>,
+            custom_vlist<int, 0, -1, 1, 2, -2>
+        >
+    );
+
+    // the merge passes have to be right for sizes that are not powers of two, also when keys repeat
+    constexpr size_t stable_by_residue(size_t size, size_t position)
+    {
+        for(size_t residue = 0;; ++residue) {
+            const size_t count = (size + 2 - residue) / 3;
+            if(position < count) {
+                return 3 * position + residue;
+            }
+            position -= count;
+        }
+    }
+
+    struct residue_order
+    {
+        constexpr bool operator()(size_t a, size_t b) const
+        {
+            return a % 3 < b % 3;
+        }
+    };
+
+    template<size_t Size, typename Indices = std::make_index_sequence<Size>>
+    struct sort_permutation;
+
+    template<size_t Size, size_t... Is>
+    struct sort_permutation<Size, std::index_sequence<Is...>>
+    {
+        template<size_t Index>
+        struct element {};
+
+        template<typename A, typename B>
+        struct before;
+
+        template<size_t A, size_t B>
+        struct before<element<A>, element<B>> : std::bool_constant<(A < B)> {};
+
+        template<typename A, typename B>
+        struct residue_before;
+
+        template<size_t A, size_t B>
+        struct residue_before<element<A>, element<B>> : std::bool_constant<(A % 3 < B % 3)> {};
+
+        static constexpr bool value =
+            are_same_v<
+                value_list::sort<vlist<size_t, ((Is * 37 + 11) % Size)...>>,
+                vlist<size_t, Is...>
+            > &&
+            are_same_v<
+                type_list::sort<tlist<element<(Is * 37 + 11) % Size>...>, before>,
+                tlist<element<Is>...>
+            > &&
+            are_same_v<
+                value_list::sort<vlist<size_t, Is...>, residue_order>,
+                vlist<size_t, stable_by_residue(Size, Is)...>
+            > &&
+            are_same_v<
+                type_list::sort<tlist<element<Is>...>, residue_before>,
+                tlist<element<stable_by_residue(Size, Is)>...>
+            >;
+    };
+
+    static_assert(
+        sort_permutation<2>::value && sort_permutation<3>::value && sort_permutation<5>::value &&
+        sort_permutation<7>::value && sort_permutation<16>::value && sort_permutation<17>::value &&
+        sort_permutation<33>::value && sort_permutation<100>::value && sort_permutation<129>::value
+    );
+
+    //
+    // contains / index_of / find_if
+    //
+
+    static_assert(
+        !type_list::contains<tlist<>, int> &&
+        type_list::contains<tlist<int, float, short>, short> &&
+        !type_list::contains<tlist<int, float, short>, double> &&
+        tlist<int, float, short>::contains<float> &&
+        type_list::contains<custom_tlist<int, void, int&>, void>
+    );
+
+    static_assert(
+        type_list::index_of<tlist<>, int> == 0 &&
+        type_list::index_of<tlist<int, float, short>, int> == 0 &&
+        type_list::index_of<tlist<int, float, short>, short> == 2 &&
+        type_list::index_of<tlist<int, float, short>, double> == 3 &&
+        tlist<int, float, short>::index_of<float> == 1
+    );
+
+    // repeated elements answer the first occurrence
+    static_assert(
+        type_list::contains<tlist<int, float, int, float>, float> &&
+        type_list::index_of<tlist<int, float, int, float>, float> == 1 &&
+        type_list::index_of<custom_tlist<short, int, float, int>, int> == 1
+    );
+
+    static_assert(
+        type_list::find_if<tlist<>, std::is_integral> == 0 &&
+        type_list::find_if<tlist<float, double, short, int>, std::is_integral> == 2 &&
+        type_list::find_if<tlist<float, double>, std::is_integral> == 2 &&
+        tlist<float, int>::find_if<std::is_integral> == 1
+    );
+
+    //
+    // unique / set_union / set_intersection / set_difference / is_subset
+    //
+
+    static_assert(
+        are_same_v<
+            type_list::unique<tlist<int, float, int, char, float, int>>,
+            tlist<int, float, int, char, float, int>::unique<>,
+            tlist<int, float, char>
+        > &&
+        are_same_v<type_list::unique<tlist<>>, tlist<>> &&
+        are_same_v<type_list::unique<custom_tlist<int, int>>, custom_tlist<int>>
+    );
+
+    static_assert(
+        are_same_v<
+            type_list::set_union<tlist<int, float, int>, tlist<char, float, short, char>>,
+            tlist<int, float, int>::set_union<tlist<char, float, short, char>>,
+            tlist<int, float, char, short>
+        > &&
+        are_same_v<type_list::set_union<tlist<>, tlist<int, int>>, tlist<int>> &&
+        are_same_v<type_list::set_union<tlist<int>, custom_tlist<float, int>>, tlist<int, float>>
+    );
+
+    static_assert(
+        are_same_v<
+            type_list::set_intersection<tlist<int, float, char, int>, tlist<char, short, int, char>>,
+            tlist<int, float, char, int>::set_intersection<tlist<char, short, int, char>>,
+            tlist<int, char>
+        > &&
+        are_same_v<type_list::set_intersection<tlist<int, float>, custom_tlist<double>>, tlist<>>
+    );
+
+    static_assert(
+        are_same_v<
+            type_list::set_difference<tlist<int, float, char, float>, tlist<char, short>>,
+            tlist<int, float, char, float>::set_difference<tlist<char, short>>,
+            tlist<int, float>
+        > &&
+        are_same_v<type_list::set_difference<tlist<int>, tlist<>>, tlist<int>>
+    );
+
+    static_assert(
+        type_list::is_subset<tlist<int, char, int>, tlist<short, char, int, char>> &&
+        !type_list::is_subset<tlist<int, long>, tlist<short, char, int>> &&
+        type_list::is_subset<tlist<>, tlist<>> &&
+        tlist<int>::is_subset<custom_tlist<float, int>>
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::unique<vlist<int, 3, 1, 3, 2, 1>>,
+            vlist<int, 3, 1, 3, 2, 1>::unique<>,
+            vlist<int, 3, 1, 2>
+        > &&
+        are_same_v<value_list::unique<vlist<int>>, vlist<int>> &&
+        are_same_v<value_list::unique<custom_vlist<char, 'a', 'a'>>, custom_vlist<char, 'a'>>
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::set_union<vlist<int, 3, 1, 3>, vlist<int, 2, 3, 4, 2>>,
+            vlist<int, 3, 1, 3>::set_union<vlist<int, 2, 3, 4, 2>>,
+            vlist<int, 3, 1, 2, 4>
+        > &&
+        are_same_v<value_list::set_union<vlist<int, 1>, custom_vlist<int, 2, 1>>, vlist<int, 1, 2>>
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::set_intersection<vlist<int, 3, 1, 2, 3>, vlist<int, 2, 3>>,
+            vlist<int, 3, 1, 2, 3>::set_intersection<vlist<int, 2, 3>>,
+            vlist<int, 3, 2>
+        > &&
+        are_same_v<value_list::set_intersection<vlist<int, 1>, custom_vlist<int>>, vlist<int>>
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::set_difference<vlist<int, 3, 1, 2, 1>, vlist<int, 2, 3>>,
+            vlist<int, 3, 1, 2, 1>::set_difference<vlist<int, 2, 3>>,
+            vlist<int, 1>
+        >
+    );
+
+    static_assert(
+        value_list::is_subset<vlist<int, 3, 1, 3>, vlist<int, 1, 2, 3>> &&
+        !value_list::is_subset<vlist<int, 3, 5>, vlist<int, 1, 2, 3>> &&
+        value_list::is_subset<vlist<int>, vlist<int>> &&
+        vlist<int, 2>::is_subset<custom_vlist<int, 2>>
+    );
+
+    // value lists of any list template can be combined, as long as their value types agree
+    template<template<typename, typename> typename Operation, typename Lhs, typename Rhs>
+    concept value_set_operation = requires { typename Operation<Lhs, Rhs>; };
+
+    template<typename Lhs, typename Rhs>
+    concept value_subset_testable = requires { value_list::is_subset<Lhs, Rhs>; };
+
+    template<typename Lhs, typename Rhs>
+    static constexpr size_t value_set_operations = value_set_operation<value_list::set_union, Lhs, Rhs> +
+        value_set_operation<value_list::set_intersection, Lhs, Rhs> + value_set_operation<value_list::set_difference, Lhs, Rhs> +
+        value_subset_testable<Lhs, Rhs>;
+
+    static_assert(
+        value_set_operations<vlist<int, 1>, custom_vlist<int, 2>> == 4 &&
+        value_set_operations<vlist<int, 1>, vlist<char, 'a'>> == 0 &&
+        value_set_operations<vlist<int, 1>, custom_vlist<long, 2>> == 0
+    );
+
+    //
+    // type_map
+    //
+
+    using test_map = type_map<tlist<std::pair<int, float>, std::pair<short, void>, std::pair<float, std::integral_constant<int, 3>>>>;
+
+    static_assert(
+        test_map::size == 3 &&
+        test_map::contains<short> &&
+        !test_map::contains<double> &&
+        !test_map::contains<void>
+    );
+
+    static_assert(
+        are_same_v<test_map::at<int>, float> &&
+        are_same_v<test_map::at<short>, void> &&
+        are_same_v<test_map::at_or<double, char>, char> &&
+        are_same_v<test_map::at_or<int, char>, float> &&
+        test_map::value_at<float> == 3
+    );
+
+    static_assert(
+        are_same_v<test_map::keys, tlist<int, short, float>> &&
+        are_same_v<test_map::values, tlist<float, void, std::integral_constant<int, 3>>>
+    );
+
+    template<typename K, typename V>
+    struct custom_pair {};
+
+    static_assert(
+        are_same_v<type_map<custom_tlist<custom_pair<int, float>>>::at<int>, float> &&
+        type_map<tlist<>>::size == 0 &&
+        !type_map<tlist<>>::contains<int>
+    );
+
+    // keys are told apart like types, int and const int are two keys
+    static_assert(
+        are_same_v<type_map<tlist<std::pair<int, float>, std::pair<const int, short>>>::at<int>, float> &&
+        are_same_v<type_map<tlist<std::pair<int, float>, std::pair<const int, short>>>::at<const int>, short> &&
+        !type_map<tlist<std::pair<int, float>, std::pair<const int, short>>>::contains<int&>
+    );
+
+
+    //
+    // avlist
+    //
+
+    inline constexpr std::array<int, 6> avlist_values = { 3, -1, 2, -3, 0, 1 };
+    inline constexpr std::array<int, 0> avlist_empty  = {};
+
+    using test_avlist = avlist<avlist_values>;
+
+    static_assert(
+        array_value_list::is_array_value_list<test_avlist> &&
+        !array_value_list::is_array_value_list<vlist<int, 1>> &&
+        !value_list::is_value_list<test_avlist>
+    );
+
+    static_assert(
+        test_avlist::size == 6 && !test_avlist::is_empty && avlist<avlist_empty>::is_empty &&
+        are_same_v<test_avlist::value_type, int> &&
+        test_avlist::get<0> == 3 && test_avlist::get<3> == -3 && value_list::get<test_avlist, 5> == 1 &&
+        test_avlist::front<> == 3 && test_avlist::back<> == 1
+    );
+
+    // the queries of value_list take an avlist
+    static_assert(
+        value_list::size<test_avlist> == 6 && !value_list::is_empty<test_avlist> && value_list::is_empty<avlist<avlist_empty>> &&
+        are_same_v<common::value_type_t<test_avlist>, int> &&
+        value_list::front<test_avlist> == 3 && value_list::back<test_avlist> == 1 && value_list::get<test_avlist, 2> == 2 &&
+        &value_list::to_array<test_avlist> == &avlist_values &&
+        value_list::lookup<test_avlist>(-3) == 3 && value_list::lookup<test_avlist>(7) == 6
+    );
+
+    struct twice_as_long
+    {
+        constexpr long operator()(int value) const
+        {
+            return 2l * value;
+        }
+    };
+
+    static_assert(
+        are_same_v<
+            test_avlist::transform<twice_as_long>::to_vlist<>,
+            vlist<long, 6, -2, 4, -6, 0, 2>
+        >
+    );
+
+    struct is_negative
+    {
+        constexpr bool operator()(int value) const
+        {
+            return value < 0;
+        }
+    };
+
+    static_assert(
+        are_same_v<
+            test_avlist::copy_if<is_negative>::to_vlist<>,
+            vlist<int, -1, -3>
+        > &&
+        are_same_v<
+            array_value_list::erase_if<test_avlist, is_negative>::to_vlist<custom_vlist>,
+            custom_vlist<int, 3, 2, 0, 1>
+        > &&
+        array_value_list::copy_if<avlist<avlist_empty>, is_negative>::is_empty
+    );
+
+    static_assert(
+        are_same_v<
+            test_avlist::sort<>::to_vlist<>,
+            vlist<int, -3, -1, 0, 1, 2, 3>
+        > &&
+        are_same_v<
+            value_list::sort<test_avlist, closer_to_zero>::to_vlist<>,
+            vlist<int, 0, -1, 1, 2, 3, -3>
+        > &&
+        avlist<avlist_empty>::sort<>::is_empty
+    );
+
+    static_assert(
+        are_same_v<
+            array_value_list::from_vlist<custom_vlist<int, 3, -1, 2, -3, 0, 1>>::to_vlist<>,
+            test_avlist::to_vlist<>,
+            vlist<int, 3, -1, 2, -3, 0, 1>
+        > &&
+        array_value_list::from_vlist<vlist<char>>::is_empty &&
+        array_value_list::from_vlist<vlist<char, 'a'>>::front<> == 'a'
+    );
+
+
+    //
+    // dispatch
+    //
+
+    template<typename Indices>
+    struct make_dispatch_test_list;
+
+    template<size_t... Is>
+    struct make_dispatch_test_list<std::index_sequence<Is...>>
+    {
+        using type = tlist<std::integral_constant<size_t, Is>...>;
+    };
+
+    template<size_t Size>
+    using dispatch_test_list = typename make_dispatch_test_list<std::make_index_sequence<Size>>::type;
+
+    struct dispatch_size_of
+    {
+        template<typename T>
+        constexpr size_t operator()() const
+        {
+            return sizeof(T);
+        }
+    };
+
+    // a compare per element up to detail::dispatch_chain_size elements, a table of function pointers beyond
+    template<size_t Size>
+    constexpr bool dispatches_every_index()
+    {
+        for(size_t index = 0; index < Size; ++index) {
+            if(dispatch<dispatch_test_list<Size>>(index, []<typename T>() { return T::value; }) != index) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(
+        dispatches_every_index<1>() && dispatches_every_index<5>() && dispatches_every_index<8>() &&
+        dispatches_every_index<9>() && dispatches_every_index<40>()
+    );
+
+    constexpr size_t dispatched_size(size_t index)
+    {
+        size_t result = 0;
+        dispatch<tlist<char, short, int, long long>>(index, [&]<typename T>() { result = sizeof(T); });
+        return result;
+    }
+
+    static_assert(
+        dispatched_size(0) == sizeof(char) && dispatched_size(3) == sizeof(long long) &&
+        dispatch<tlist<char, int, short>>(1, dispatch_size_of{}) == sizeof(int)
+    );
+
+    // f must return the same type for every element
+    template<typename List, typename F>
+    concept dispatchable = requires(F f) { dispatch<List>(0, f); };
+
+    static_assert(
+        dispatchable<tlist<int, float>, dispatch_size_of> &&
+        !dispatchable<tlist<int, float>, decltype([]<typename T>() { return T{}; })> &&
+        !dispatchable<tlist<>, dispatch_size_of>
+    );
+
+
+    //
+    // dispatch2
+    //
+
+    // the pair (A, B) of the test lists as A * 100 + B
+    struct dispatch2_pair
+    {
+        template<typename A, typename B>
+        constexpr size_t operator()() const
+        {
+            return A::value * 100 + B::value;
+        }
+    };
+
+    template<size_t SizeA, size_t SizeB>
+    constexpr bool dispatches_every_pair()
+    {
+        for(size_t ia = 0; ia < SizeA; ++ia) {
+            for(size_t ib = 0; ib < SizeB; ++ib) {
+                if(dispatch2<dispatch_test_list<SizeA>, dispatch_test_list<SizeB>>(ia, ib, dispatch2_pair{}) != ia * 100 + ib) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static_assert(dispatches_every_pair<1, 1>() && dispatches_every_pair<3, 7>() && dispatches_every_pair<12, 5>());
+
+    // symmetric tables hold each unordered pair once and call f in list order
+    template<size_t Size>
+    constexpr bool dispatches_every_pair_symmetric()
+    {
+        for(size_t ia = 0; ia < Size; ++ia) {
+            for(size_t ib = 0; ib < Size; ++ib) {
+                if(dispatch2_symmetric<dispatch_test_list<Size>>(ia, ib, dispatch2_pair{}) != std::min(ia, ib) * 100 + std::max(ia, ib)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static_assert(
+        dispatches_every_pair_symmetric<1>() && dispatches_every_pair_symmetric<6>() &&
+        detail::dispatch2_cells<dispatch_test_list<6>, dispatch_test_list<6>, true, detail::allow_all_pairs>::count == 21
+    );
+
+    // only pairs of the same size are held, the others miss
+    template<typename A, typename B>
+    struct same_size_pair : std::bool_constant<sizeof(A) == sizeof(B)>
+    {};
+
+    using dispatch2_types = tlist<char, std::uint32_t, std::uint8_t, std::uint64_t, float>;
+
+    constexpr size_t same_size_dispatched(size_t ia, size_t ib)
+    {
+        return dispatch2<dispatch2_types, dispatch2_types, same_size_pair>(
+            ia, ib, []<typename A, typename B>() { return sizeof(A); }, [] { return size_t(0); });
+    }
+
+    constexpr size_t same_size_dispatched_symmetric(size_t ia, size_t ib)
+    {
+        return dispatch2_symmetric<dispatch2_types, same_size_pair>(
+            ia, ib, []<typename A, typename B>() { return sizeof(A) + sizeof(B); }, [] { return size_t(0); });
+    }
+
+    static_assert(
+        detail::dispatch2_cells<dispatch2_types, dispatch2_types, false, same_size_pair>::count == 9 &&
+        detail::dispatch2_cells<dispatch2_types, dispatch2_types, true, same_size_pair>::count == 7 &&
+        same_size_dispatched(0, 2) == 1 && same_size_dispatched(4, 1) == 4 && same_size_dispatched(3, 3) == 8 &&
+        same_size_dispatched(0, 1) == 0 && same_size_dispatched(3, 4) == 0 &&
+        same_size_dispatched_symmetric(2, 0) == 2 && same_size_dispatched_symmetric(1, 4) == 8 &&
+        same_size_dispatched_symmetric(0, 3) == 0
+    );
+
+    // f must return the same type for every held pair
+    template<typename ListA, typename ListB, typename F>
+    concept dispatchable2 = requires(F f) { dispatch2<ListA, ListB>(0, 0, f); };
+
+    static_assert(
+        dispatchable2<tlist<int, float>, tlist<char>, dispatch2_pair> &&
+        !dispatchable2<tlist<int, float>, tlist<char>, decltype([]<typename A, typename B>() { return A{}; })> &&
+        !dispatchable2<tlist<>, tlist<char>, dispatch2_pair>
+    );
+
+
+    //
+    // value_list::lookup
+    //
+
+    using dense_keys = vlist<int, 5, 3, 9, 3, 7>;
+
+    static_assert(
+        detail::value_lookup<dense_keys>::strategy == detail::lookup_strategy::dense &&
+        value_list::lookup<dense_keys>(5) == 0 && value_list::lookup<dense_keys>(3) == 1 && value_list::lookup<dense_keys>(9) == 2 &&
+        value_list::lookup<dense_keys>(7) == 4 && value_list::lookup<dense_keys>(4) == 5 && value_list::lookup<dense_keys>(-1) == 5 &&
+        value_list::lookup<dense_keys>(100) == 5 &&
+        value_list::lookup<vlist<int>>(0) == 0
+    );
+
+    using sparse_keys = vlist<long long, 100000, -7, LLONG_MIN, 0, LLONG_MAX>;
+
+    static_assert(
+        detail::value_lookup<sparse_keys>::strategy == detail::lookup_strategy::binary_search &&
+        value_list::lookup<sparse_keys>(-7) == 1 && value_list::lookup<sparse_keys>(LLONG_MIN) == 2 &&
+        value_list::lookup<sparse_keys>(LLONG_MAX) == 4 && value_list::lookup<sparse_keys>(1) == 5
+    );
+
+    // 300 message ids spread over 16 bits
+    template<typename Indices>
+    struct make_message_ids;
+
+    template<size_t... Is>
+    struct make_message_ids<std::index_sequence<Is...>>
+    {
+        using type = vlist<std::uint16_t, static_cast<std::uint16_t>(Is * 211 + Is * Is % 97)...>;
+    };
+
+    using message_ids = typename make_message_ids<std::make_index_sequence<300>>::type;
+
+    // every id at its position, the values next to them miss
+    constexpr bool finds_every_message_id()
+    {
+        const auto& ids = value_list::to_array<message_ids>;
+        for(size_t i = 0; i < ids.size(); ++i) {
+            if(value_list::lookup<message_ids>(ids[i]) != i ||
+               value_list::lookup<message_ids>(static_cast<std::uint16_t>(ids[i] + 1)) != 300 ||
+               value_list::lookup<message_ids>(static_cast<std::uint16_t>(ids[i] - 1)) != 300) {
+                return false;
+            }
+        }
+        return value_list::lookup<message_ids>(UINT16_MAX) == 300;
+    }
+
+    static_assert(
+        detail::value_lookup<message_ids>::strategy == detail::lookup_strategy::perfect_hash &&
+        finds_every_message_id()
+    );
+
+    // routed to the types at the same positions
+    constexpr size_t routed_size(char key)
+    {
+        return dispatch_key<vlist<char, 'x', 'p', 'a'>, tlist<char, short, long long>>(key, dispatch_size_of{}, [] { return size_t(0); });
+    }
+
+    static_assert(routed_size('p') == sizeof(short) && routed_size('a') == sizeof(long long) && routed_size('b') == 0);
+
+
+    //
+    // match_keyword
+    //
+
+    using commands = keywords<"get", "set", "del", "getset", "ge", "", "setex", "set", "\xff\x01">;
+
+    template<keyword_prefilter Prefilter>
+    constexpr bool matches_commands()
+    {
+        constexpr auto match = [](std::string_view text) { return match_keyword<commands, Prefilter>(text); };
+        return
+            match("get") == 0 && match("set") == 1 && match("del") == 2 && match("getset") == 3 && match("ge") == 4 &&
+            match("") == 5 && match("setex") == 6 && match("\xff\x01") == 8 &&
+            match("g") == 9 && match("gets") == 9 && match("getsetx") == 9 && match("GET") == 9 && match("xyz") == 9 &&
+            match("sex") == 9 && match("\xff") == 9 && match(std::string_view("get\0", 4)) == 9;
+    }
+
+    // duplicates match their first occurrence, the prefix "ge" of "get" is a keyword of its own
+    static_assert(
+        std::is_same_v<commands, tlist<keyword<"get">, keyword<"set">, keyword<"del">, keyword<"getset">, keyword<"ge">,
+                                       keyword<"">, keyword<"setex">, keyword<"set">, keyword<"\xff\x01">>> &&
+        matches_commands<keyword_prefilter::none>() && matches_commands<keyword_prefilter::first_byte>() &&
+        match_keyword<keywords<>>("get") == 0 &&
+        match_keyword<keywords<"a">>("a") == 0 && match_keyword<keywords<"a">>("b") == 1 && match_keyword<keywords<"a">>("") == 1
+    );
+
+    // one state per distinct prefix and the dead state, one class per distinct byte and the class of all others
+    static_assert(
+        detail::keyword_matcher<commands>::states == 18 &&
+        detail::keyword_matcher<commands>::classes == 10 &&
+        std::is_same_v<detail::keyword_matcher<commands>::state, std::uint8_t>
+    );
+
+    constexpr size_t command_size(std::string_view text)
+    {
+        return dispatch_keyword<keywords<"ping", "echo", "quit">>(
+            text, []<typename Command>() { return Command::value.size() * 10; }, [] { return size_t(0); });
+    }
+
+    static_assert(command_size("ping") == 40 && command_size("quit") == 40 && command_size("pong") == 0);
+
+    template<typename Keywords>
+    concept keyword_matchable = requires(std::string_view text) { match_keyword<Keywords>(text); };
+
+    // only lists of keyword<...> are matched, other types with a ::value are not keywords
+    static_assert(
+        keyword_matchable<keywords<"a", "b">> && keyword_matchable<custom_tlist<keyword<"a">>> && keyword_matchable<keywords<>> &&
+        !keyword_matchable<tlist<keyword<"a">, std::integral_constant<int, 1>>> && !keyword_matchable<tlist<std::string_view>>
+    );
+
+}
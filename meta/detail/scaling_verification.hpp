@@ -0,0 +1,287 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "../tlist.hpp"
+#include "../vlist.hpp"
+#include "../lookup.hpp"
+#include "../keyword.hpp"
+#include "../util.hpp"
+#include <cstdint>
+#include <utility>
+
+//
+// Scaling verification
+// Instantiates the list algorithms on lists of scaling_size elements. This compiles under the default
+// -ftemplate-depth only as long as the algorithms keep their recursion depth independent of the list size,
+// and the compile time of this translation unit is the benchmark for their total cost.
+//
+
+namespace meta::verification::scaling {
+
+    static constexpr size_t scaling_size = 10000;
+
+    template<size_t Index>
+    struct element {};
+
+    template<typename Indices>
+    struct make_lists;
+
+    template<size_t... Is>
+    struct make_lists<std::index_sequence<Is...>>
+    {
+        using types         = tlist<element<Is>...>;
+        using reverse_types = tlist<element<sizeof...(Is) - 1 - Is>...>;
+        using values        = vlist<size_t, Is...>;
+        using reverse_values = vlist<size_t, (sizeof...(Is) - 1 - Is)...>;
+    };
+
+    using lists = make_lists<std::make_index_sequence<scaling_size>>;
+
+    //
+    // reverse
+    //
+
+    static_assert(
+        are_same_v<
+            type_list::reverse<lists::types>,
+            lists::reverse_types
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::reverse<lists::values>,
+            lists::reverse_values
+        >
+    );
+
+    //
+    // pop_back
+    //
+
+    static_assert(
+        are_same_v<
+            type_list::back<type_list::pop_back<lists::types>>,
+            element<scaling_size - 2>
+        > &&
+        (type_list::size<type_list::pop_back<lists::types>> == scaling_size - 1)
+    );
+
+    static_assert(
+        value_list::back<value_list::pop_back<lists::values>> == scaling_size - 2 &&
+        value_list::size<value_list::pop_back<lists::values>> == scaling_size - 1
+    );
+
+    //
+    // get / split
+    //
+
+    static_assert(
+        are_same_v<
+            type_list::get<lists::types, scaling_size - 1>,
+            element<scaling_size - 1>
+        >
+    );
+
+    static_assert(
+        value_list::get<lists::values, scaling_size - 1> == scaling_size - 1
+    );
+
+    static_assert(
+        are_same_v<
+            type_list::front<typename type_list::split<lists::types, scaling_size / 2>::rhs>,
+            element<scaling_size / 2>
+        > &&
+        (type_list::size<typename type_list::split<lists::types, scaling_size / 2>::lhs> == scaling_size / 2)
+    );
+
+    static_assert(
+        value_list::front<typename common::split_t<lists::values, scaling_size / 2>::rhs> == scaling_size / 2 &&
+        value_list::size<typename common::split_t<lists::values, scaling_size / 2>::lhs> == scaling_size / 2
+    );
+
+    //
+    // erase_if / copy_if
+    // The filters instantiate a join per element, so they run on lists of handler-table size rather than scaling_size.
+    //
+
+    static constexpr size_t filter_size = 2000;
+
+    using filter_lists = make_lists<std::make_index_sequence<filter_size>>;
+
+    template<typename T>
+    struct is_odd_element;
+
+    template<size_t Index>
+    struct is_odd_element<element<Index>>
+    {
+        static constexpr bool value = (Index % 2) != 0;
+    };
+
+    template<auto V>
+    struct is_odd_value
+    {
+        static constexpr bool value = (V % 2) != 0;
+    };
+
+    static_assert(
+        are_same_v<
+            type_list::back<type_list::erase_if<filter_lists::types, is_odd_element>>,
+            element<filter_size - 2>
+        > &&
+        (type_list::size<type_list::erase_if<filter_lists::types, is_odd_element>> == filter_size / 2)
+    );
+
+    static_assert(
+        value_list::back<value_list::copy_if<filter_lists::values, is_odd_value>> == filter_size - 1 &&
+        value_list::size<value_list::copy_if<filter_lists::values, is_odd_value>> == filter_size / 2
+    );
+
+    //
+    // contains / index_of / find_if
+    //
+
+    static_assert(
+        type_list::contains<lists::types, element<scaling_size - 1>> &&
+        !type_list::contains<lists::types, element<scaling_size>>
+    );
+
+    static_assert(
+        type_list::index_of<lists::types, element<scaling_size - 1>> == scaling_size - 1 &&
+        type_list::index_of<lists::types, element<scaling_size / 2>> == scaling_size / 2 &&
+        type_list::index_of<lists::types, element<scaling_size>> == scaling_size
+    );
+
+    static_assert(
+        type_list::find_if<lists::reverse_types, is_odd_element> == 0 &&
+        type_list::find_if<lists::types, is_odd_element> == 1
+    );
+
+    //
+    // sort
+    // Type lists pay an instantiation per merge step, N log N in total, so they are sorted at filter_size.
+    //
+
+    template<typename A, typename B>
+    struct element_before;
+
+    template<size_t A, size_t B>
+    struct element_before<element<A>, element<B>> : std::bool_constant<(A < B)> {};
+
+    static_assert(
+        are_same_v<
+            type_list::sort<filter_lists::reverse_types, element_before>,
+            filter_lists::types
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            value_list::sort<lists::reverse_values>,
+            lists::values
+        >
+    );
+
+
+    //
+    // lookup
+    // Keys spread over 32 bits, too sparse for the dense table. Up to detail::lookup_max_hashed_keys of them get a
+    // perfect hash, every seed a constant evaluation of its own, scaling_size of them are left to the binary search.
+    //
+
+    constexpr std::uint32_t sparse_key(size_t index)
+    {
+        return static_cast<std::uint32_t>((index * 2654435761u) ^ (index << 7));
+    }
+
+    template<typename Indices>
+    struct make_sparse_keys;
+
+    template<size_t... Is>
+    struct make_sparse_keys<std::index_sequence<Is...>>
+    {
+        using type = vlist<std::uint32_t, sparse_key(Is)...>;
+    };
+
+    using hashed_keys = typename make_sparse_keys<std::make_index_sequence<detail::lookup_max_hashed_keys>>::type;
+    using sparse_keys = typename make_sparse_keys<std::make_index_sequence<scaling_size>>::type;
+
+    template<typename Keys>
+    constexpr bool finds_every_key()
+    {
+        for(size_t i = 0; i < value_list::size<Keys>; ++i) {
+            if(value_list::lookup<Keys>(sparse_key(i)) != i) {
+                return false;
+            }
+        }
+        return value_list::lookup<Keys>(sparse_key(value_list::size<Keys>)) == value_list::size<Keys>;
+    }
+
+    static_assert(
+        detail::value_lookup<hashed_keys>::strategy == detail::lookup_strategy::perfect_hash &&
+        finds_every_key<hashed_keys>()
+    );
+
+    static_assert(
+        detail::value_lookup<sparse_keys>::strategy == detail::lookup_strategy::binary_search &&
+        finds_every_key<sparse_keys>()
+    );
+
+
+    //
+    // match_keyword
+    // Random keywords of 3 to 12 letters, sizing and building the trie takes time in the number of characters.
+    //
+
+    static constexpr size_t keyword_count = 300;
+
+    constexpr std::uint64_t keyword_mix(std::uint64_t x)
+    {
+        x = (x ^ (x >> 31)) * 0x7FB5D329728EA185ull;
+        return x ^ (x >> 27);
+    }
+
+    constexpr size_t keyword_length(size_t index)
+    {
+        return 3 + static_cast<size_t>(keyword_mix(index) % 10);
+    }
+
+    template<size_t Index>
+    constexpr fixed_string<keyword_length(Index) + 1> generated_keyword()
+    {
+        char chars[keyword_length(Index) + 1]{};
+        for(size_t i = 0; i < keyword_length(Index); ++i) {
+            chars[i] = static_cast<char>('a' + keyword_mix(Index * 16 + i + 1) % 26);
+        }
+        return fixed_string<keyword_length(Index) + 1>(chars);
+    }
+
+    template<typename Indices>
+    struct make_keywords;
+
+    template<size_t... Is>
+    struct make_keywords<std::index_sequence<Is...>>
+    {
+        using type = keywords<generated_keyword<Is>()...>;
+    };
+
+    using generated_keywords = typename make_keywords<std::make_index_sequence<keyword_count>>::type;
+
+    // every keyword matches itself or an equal one before it
+    constexpr bool matches_every_keyword()
+    {
+        const auto& words = detail::keyword_views<generated_keywords>::value;
+        for(size_t i = 0; i < keyword_count; ++i) {
+            const size_t match = match_keyword<generated_keywords>(words[i]);
+            if(match > i || words[match] != words[i]) {
+                return false;
+            }
+        }
+        return match_keyword<generated_keywords>("ab") == keyword_count;
+    }
+
+    static_assert(matches_every_keyword());
+
+}
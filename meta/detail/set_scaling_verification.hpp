@@ -0,0 +1,72 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "../tlist.hpp"
+#include "../vlist.hpp"
+#include "../util.hpp"
+#include <utility>
+
+//
+// Set scaling verification
+// Like the scaling verification, in a translation unit of its own to keep the peak memory of either one down.
+// A membership query is an overload resolution against the whole set, and a repeated type is resolved to its first
+// index by a scan, so the type list versions run on set_size lists where every element occurs twice. That is past the
+// default -ftemplate-depth, which is what matters here. The value list versions sort constexpr arrays and run on
+// larger lists.
+//
+
+namespace meta::verification::set_scaling {
+
+    static constexpr size_t set_size   = 1000;
+    static constexpr size_t value_size = 2000;
+
+    template<size_t Index>
+    struct element {};
+
+    template<typename Indices>
+    struct make_lists;
+
+    // every element twice, and a list that shares the upper half of it
+    template<size_t... Is>
+    struct make_lists<std::index_sequence<Is...>>
+    {
+        using types          = tlist<element<Is % (sizeof...(Is) / 2)>...>;
+        using shifted_types  = tlist<element<Is + sizeof...(Is) / 4>...>;
+        using values         = vlist<size_t, (Is % (sizeof...(Is) / 2))...>;
+        using shifted_values = vlist<size_t, (Is + sizeof...(Is) / 4)...>;
+    };
+
+    using type_lists  = make_lists<std::make_index_sequence<set_size>>;
+    using value_lists = make_lists<std::make_index_sequence<value_size>>;
+
+    //
+    // unique / set_union / set_intersection / set_difference / is_subset
+    //
+
+    static_assert(
+        type_list::size<type_list::unique<type_lists::types>> == set_size / 2 &&
+        type_list::size<type_list::set_intersection<type_lists::types, type_lists::shifted_types>> == set_size / 4 &&
+        type_list::size<type_list::set_difference<type_lists::types, type_lists::shifted_types>> == set_size / 4 &&
+        type_list::size<type_list::set_union<type_lists::types, type_lists::shifted_types>> == set_size + set_size / 4
+    );
+
+    static_assert(
+        type_list::is_subset<type_list::unique<type_lists::types>, type_lists::types> &&
+        !type_list::is_subset<type_lists::shifted_types, type_lists::types>
+    );
+
+    static_assert(
+        value_list::size<value_list::unique<value_lists::values>> == value_size / 2 &&
+        value_list::size<value_list::set_intersection<value_lists::values, value_lists::shifted_values>> == value_size / 4 &&
+        value_list::size<value_list::set_difference<value_lists::values, value_lists::shifted_values>> == value_size / 4 &&
+        value_list::size<value_list::set_union<value_lists::values, value_lists::shifted_values>> == value_size + value_size / 4
+    );
+
+    static_assert(
+        value_list::is_subset<value_list::unique<value_lists::values>, value_lists::values> &&
+        !value_list::is_subset<value_lists::shifted_values, value_lists::values>
+    );
+
+}
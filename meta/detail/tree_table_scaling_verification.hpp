@@ -0,0 +1,104 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "../tree_table.hpp"
+#include "../tree_dispatch.hpp"
+#include "../tlist.hpp"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+//
+// tree_table scaling verification
+// A tree with 1024 leaves. The stepwise lr traversal cannot reach leaf 1000 within the default template depth, the
+// random access traversal gets there (and to the end) with one jump each. leaf_path_of and leaf_index_of take a step
+// per level instead, leaf_index_of_type one lookup in the leaf list. tree_dispatch reaches every leaf from its path at
+// runtime, through the jump tables as well as through the flattened table of 5^5 paths.
+//
+
+namespace meta::verification::tree_table_scaling {
+
+    template<size_t Index>
+    struct leaf {};
+
+    template<typename... Children>
+    struct node {};
+
+    template<size_t Depth, size_t First>
+    struct quad_tree
+    {
+        static constexpr size_t span = size_t(1) << (2 * (Depth - 1));
+
+        using type = node<
+            typename quad_tree<Depth - 1, First + 0 * span>::type,
+            typename quad_tree<Depth - 1, First + 1 * span>::type,
+            typename quad_tree<Depth - 1, First + 2 * span>::type,
+            typename quad_tree<Depth - 1, First + 3 * span>::type
+        >;
+    };
+
+    template<size_t First>
+    struct quad_tree<0, First>
+    {
+        using type = leaf<First>;
+    };
+
+    using tree  = typename quad_tree<5, 0>::type;
+    using table = tree_table<tree, contexts::tlist>;
+    using by_leaf = traversals::random_access<traversals::lr>;
+
+    static_assert(table::size == 1365 && table::num_leaves == 1024 && table::depth[table::leaves[1023]] == 5);
+
+    static_assert(
+        std::is_same_v<dereference_t<advance_n_t<tree_begin<tree, contexts::tlist, by_leaf>, 1000>>, leaf<1000>> &&
+        std::is_same_v<dereference_t<advance_n_t<tree_range_t<tree, contexts::tlist, by_leaf>, 517>>, leaf<517>> &&
+        std::is_same_v<advance_n_t<tree_begin<tree, contexts::tlist, by_leaf>, 1024>, tree_end<tree, contexts::tlist, by_leaf>> &&
+        type_list::size<path_t<advance_n_t<tree_begin<tree, contexts::tlist, by_leaf>, 700>>> == 6 &&
+        iterator_distance_v<advance_n_t<tree_begin<tree, contexts::tlist, by_leaf>, 24>, tree_end<tree, contexts::tlist, by_leaf>> == 1000
+    );
+
+    static_assert(
+        std::is_same_v<leaf_path_of_t<tree, contexts::tlist, 1000>, vlist<size_t, 3, 3, 2, 2, 0>> &&
+        leaf_index_of_v<tree, contexts::tlist, vlist<size_t, 3, 3, 2, 2, 0>> == 1000 &&
+        leaf_index_of_type_v<tree, contexts::tlist, leaf<1000>> == 1000 &&
+        leaf_index_of_type_v<tree, contexts::tlist, leaf<1023>> == 1023
+    );
+
+
+    template<size_t Index>
+    constexpr size_t leaf_number(leaf<Index>*)
+    {
+        return Index;
+    }
+
+    template<tree_dispatch_mode Mode>
+    constexpr size_t dispatched_leaf(std::span<const std::uint8_t> path)
+    {
+        return tree_dispatch<tree, contexts::tlist, Mode>(
+            path, []<typename Leaf>() { return leaf_number(static_cast<Leaf*>(nullptr)); }, [] { return size_t(1024); });
+    }
+
+    template<tree_dispatch_mode Mode>
+    constexpr bool dispatches_every_leaf()
+    {
+        for(size_t index = 0; index < 1024; ++index) {
+            const std::array<std::uint8_t, 5> path = {
+                std::uint8_t(index >> 8 & 3), std::uint8_t(index >> 6 & 3), std::uint8_t(index >> 4 & 3), std::uint8_t(index >> 2 & 3), std::uint8_t(index & 3)
+            };
+            if(dispatched_leaf<Mode>(path) != index) {
+                return false;
+            }
+        }
+        return dispatched_leaf<Mode>(std::array<std::uint8_t, 4>{ 3, 3, 2, 2 }) == 1024;
+    }
+
+    static_assert(
+        detail::tree_dispatcher<tree, contexts::tlist>::small &&
+        dispatches_every_leaf<tree_dispatch_mode::jump_tables>() &&
+        dispatches_every_leaf<tree_dispatch_mode::flattened>()
+    );
+
+}
@@ -1,7 +1,13 @@
 #include <meta/tree.hpp>
+#include <meta/tree_table.hpp>
+#include <meta/tree_dispatch.hpp>
 #include <meta/tlist.hpp>
 #include <meta/util.hpp>
 #include <meta/algorithm.hpp>
+#include <meta/vlist.hpp>
+#include <array>
+#include <cstdint>
+#include <span>
 
 namespace meta::verification {
 
@@ -431,4 +437,734 @@ namespace meta::verification {
         >
     );
 
+    //
+    // accumulate over a complete range_lr on contexts::tlist goes through type_list::flatten
+    //
+
+    static_assert(
+        are_same_v<
+            accumulate_t<range_lr<advance_test_tree, contexts::tlist>>,
+            meta::tlist<tlist_leaf<0>, tlist_leaf<1>, tlist_leaf<2>>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            accumulate_t<range_lr<meta::tlist<meta::tlist<meta::tlist<tlist_leaf<0>>, tlist_leaf<1>>, tlist_leaf<2>>, contexts::tlist>>,
+            meta::tlist<tlist_leaf<0>, tlist_leaf<1>, tlist_leaf<2>>
+        >
+    );
+
+    static_assert(
+        are_same_v<
+            accumulate_t<range_lr<tlist_leaf<0>, contexts::tlist>>,
+            meta::tlist<tlist_leaf<0>>
+        >
+    );
+
+    // a partial range still advances step by step
+    static_assert(
+        are_same_v<
+            accumulate_t<advance_t<range_lr<advance_test_tree, contexts::tlist>>>,
+            meta::tlist<tlist_leaf<1>, tlist_leaf<2>>
+        >
+    );
+
+
+    //
+    // contexts::indexed keeps the root and the child indices instead of a stack of ancestors
+    //
+
+    using indexed_tlist = contexts::indexed<contexts::tlist>;
+
+    static_assert(
+        are_same_v<
+            tree_begin<advance_test_tree, indexed_tlist, traversals::lr>,
+            tree_iterator<indexed_tlist, detail::index_path<advance_test_tree, 0, 0>, traversals::lr>
+        > &&
+        are_same_v<
+            detail::index_path<advance_test_tree, 0, 1>::indices,
+            vlist<size_t, 0, 1>
+        > &&
+        !concepts::TypeList<detail::index_path<advance_test_tree>>
+    );
+
+    static_assert(
+        are_same_v<dereference_t<advance_n_t<tree_begin<advance_test_tree, indexed_tlist>, 0>>, advance_test_tree> &&
+        are_same_v<dereference_t<advance_n_t<tree_begin<advance_test_tree, indexed_tlist>, 1>>, tlist_tree<tlist_leaf<0>, tlist_leaf<1>>> &&
+        are_same_v<dereference_t<advance_n_t<tree_begin<advance_test_tree, indexed_tlist>, 2>>, tlist_leaf<0>> &&
+        are_same_v<dereference_t<advance_n_t<tree_begin<advance_test_tree, indexed_tlist>, 3>>, tlist_leaf<1>> &&
+        are_same_v<dereference_t<advance_n_t<tree_begin<advance_test_tree, indexed_tlist>, 4>>, tlist_leaf<2>> &&
+        are_same_v<advance_n_t<tree_begin<advance_test_tree, indexed_tlist>, 5>, tree_end<advance_test_tree, indexed_tlist>>
+    );
+
+    // the same paths as the default stack
+    static_assert(
+        are_same_v<
+            path_t<advance_n_t<tree_begin<advance_test_tree, indexed_tlist>, 3>>,
+            path_t<advance_n_t<tree_begin<advance_test_tree, contexts::tlist>, 3>>,
+            meta::tlist<advance_test_tree, tlist_tree<tlist_leaf<0>, tlist_leaf<1>>, tlist_leaf<1>>
+        > &&
+        are_same_v<
+            path_t<tree_begin<advance_test_tree, indexed_tlist>>,
+            meta::tlist<advance_test_tree>
+        >
+    );
+
+    using indexed_intrusive_tree = intrusive_tree<intrusive_tree<intrusive_leaf<0>, intrusive_leaf<1>>, intrusive_leaf<2>>;
+
+    static_assert(
+        are_same_v<
+            accumulate_t<range_nlr<indexed_intrusive_tree, contexts::indexed<contexts::intrusive>>>,
+            accumulate_t<range_nlr<indexed_intrusive_tree, contexts::intrusive>>
+        > &&
+        are_same_v<
+            accumulate_t<range_lr<indexed_intrusive_tree, contexts::indexed<contexts::intrusive>>>,
+            meta::tlist<intrusive_leaf<0>, intrusive_leaf<1>, intrusive_leaf<2>>
+        > &&
+        are_same_v<
+            accumulate_t<range_lr<advance_test_tree, indexed_tlist>>,
+            accumulate_t<advance_t<range_lr<advance_test_tree, indexed_tlist>>>::push_front<tlist_leaf<0>>
+        >
+    );
+
+    //
+    // post-order and level-order
+    //
+
+    static_assert(
+        are_same_v<
+            accumulate_t<range_lrn<advance_test_tree, contexts::tlist>>,
+            meta::tlist<tlist_leaf<0>, tlist_leaf<1>, tlist_tree<tlist_leaf<0>, tlist_leaf<1>>, tlist_leaf<2>, advance_test_tree>
+        > &&
+        are_same_v<
+            accumulate_t<range_bfs<advance_test_tree, contexts::tlist>>,
+            meta::tlist<advance_test_tree, tlist_tree<tlist_leaf<0>, tlist_leaf<1>>, tlist_leaf<2>, tlist_leaf<0>, tlist_leaf<1>>
+        > &&
+        are_same_v<
+            path_t<advance_n_t<tree_begin<advance_test_tree, contexts::tlist, traversals::lrn>, 1>>,
+            meta::tlist<advance_test_tree, tlist_tree<tlist_leaf<0>, tlist_leaf<1>>, tlist_leaf<1>>
+        > &&
+        are_same_v<
+            advance_n_t<tree_begin<advance_test_tree, contexts::tlist, traversals::lrn>, 5>,
+            tree_end<advance_test_tree, contexts::tlist, traversals::lrn>
+        > &&
+        are_same_v<
+            advance_n_t<tree_begin<advance_test_tree, contexts::tlist, traversals::level_order>, 5>,
+            tree_end<advance_test_tree, contexts::tlist, traversals::level_order>
+        >
+    );
+
+    // subtrees of different depth, levels are completed across them
+    using level_test_tree =
+        tlist_tree<
+            tlist_leaf<0>,
+            tlist_tree<
+                tlist_leaf<1>,
+                tlist_tree<
+                    tlist_leaf<2>
+                >
+            >,
+            tlist_tree<
+                tlist_leaf<3>
+            >,
+            tlist_leaf<4>
+        >;
+
+    static_assert(
+        are_same_v<
+            accumulate_t<range_bfs<level_test_tree, contexts::tlist>>,
+            meta::tlist<
+                level_test_tree,
+                tlist_leaf<0>, tlist_tree<tlist_leaf<1>, tlist_tree<tlist_leaf<2>>>, tlist_tree<tlist_leaf<3>>, tlist_leaf<4>,
+                tlist_leaf<1>, tlist_tree<tlist_leaf<2>>, tlist_leaf<3>,
+                tlist_leaf<2>
+            >
+        > &&
+        are_same_v<
+            accumulate_t<range_lrn<level_test_tree, contexts::tlist>>,
+            meta::tlist<
+                tlist_leaf<0>, tlist_leaf<1>, tlist_leaf<2>, tlist_tree<tlist_leaf<2>>, tlist_tree<tlist_leaf<1>, tlist_tree<tlist_leaf<2>>>,
+                tlist_leaf<3>, tlist_tree<tlist_leaf<3>>, tlist_leaf<4>, level_test_tree
+            >
+        > &&
+        are_same_v<
+            dereference_t<advance_n_t<tree_begin<level_test_tree, contexts::tlist, traversals::level_order>, 7>>,
+            tlist_leaf<3>
+        > &&
+        are_same_v<
+            path_t<advance_n_t<tree_begin<level_test_tree, contexts::tlist, traversals::level_order>, 7>>,
+            meta::tlist<level_test_tree, tlist_tree<tlist_leaf<3>>, tlist_leaf<3>>
+        >
+    );
+
+    // any context, also indexed
+    static_assert(
+        are_same_v<
+            accumulate_t<range_lrn<indexed_intrusive_tree, contexts::intrusive>>,
+            meta::tlist<intrusive_leaf<0>, intrusive_leaf<1>, intrusive_tree<intrusive_leaf<0>, intrusive_leaf<1>>, intrusive_leaf<2>, indexed_intrusive_tree>
+        > &&
+        are_same_v<
+            accumulate_t<range_bfs<indexed_intrusive_tree, contexts::intrusive>>,
+            meta::tlist<indexed_intrusive_tree, intrusive_tree<intrusive_leaf<0>, intrusive_leaf<1>>, intrusive_leaf<2>, intrusive_leaf<0>, intrusive_leaf<1>>
+        > &&
+        are_same_v<
+            accumulate_t<range_lrn<level_test_tree, indexed_tlist>>,
+            accumulate_t<range_lrn<level_test_tree, contexts::tlist>>
+        > &&
+        are_same_v<
+            accumulate_t<range_bfs<level_test_tree, indexed_tlist>>,
+            accumulate_t<range_bfs<level_test_tree, contexts::tlist>>
+        > &&
+        are_same_v<
+            accumulate_t<range_bfs<tlist_leaf<0>, contexts::tlist>>,
+            accumulate_t<range_lrn<tlist_leaf<0>, contexts::tlist>>,
+            meta::tlist<tlist_leaf<0>>
+        >
+    );
+
+    //
+    // lazy end sentinels, retreat and reverse ranges
+    //
+
+    // the last child of this tree cannot be instantiated, begin/end comparisons never touch it
+    struct unfinished_tree
+    {
+        static constexpr size_t num_children = 2;
+
+        template<size_t Idx>
+        requires(Idx == 0)
+        using get_child = intrusive_leaf<0>;
+    };
+
+    static_assert(
+        concepts::Sentinel<tree_end<unfinished_tree>> &&
+        !iterator_equal_v<tree_begin<unfinished_tree>, tree_end<unfinished_tree>> &&
+        are_same_v<
+            tree_end<advance_test_tree, contexts::tlist, traversals::lr>,
+            sentinel<tree_past_end<contexts::tlist, advance_test_tree, traversals::lr>>
+        >
+    );
+
+    static_assert(
+        are_same_v<dereference_t<retreat_t<tree_end<advance_test_tree, contexts::tlist>>>, tlist_leaf<2>> &&
+        are_same_v<dereference_t<retreat_n_t<tree_end<advance_test_tree, contexts::tlist>, 3>>, tlist_leaf<0>> &&
+        are_same_v<retreat_n_t<tree_end<advance_test_tree, contexts::tlist>, 5>, tree_begin<advance_test_tree, contexts::tlist>> &&
+        are_same_v<retreat_n_t<tree_end<level_test_tree, contexts::tlist, traversals::lr>, 5>, tree_begin<level_test_tree, contexts::tlist, traversals::lr>> &&
+        are_same_v<retreat_n_t<tree_end<level_test_tree, indexed_tlist, traversals::lrn>, 9>, tree_begin<level_test_tree, indexed_tlist, traversals::lrn>> &&
+        are_same_v<retreat_t<advance_n_t<tree_begin<level_test_tree, contexts::tlist, traversals::level_order>, 5>>, advance_n_t<tree_begin<level_test_tree, contexts::tlist, traversals::level_order>, 4>> &&
+        concepts::BidirectionalIterator<tree_end<advance_test_tree, contexts::tlist>> &&
+        !concepts::BidirectionalIterator<tree_begin<advance_test_tree, contexts::tlist>>
+    );
+
+    static_assert(
+        are_same_v<
+            accumulate_t<tree_reverse_range_t<advance_test_tree, contexts::tlist>>,
+            type_list::reverse<accumulate_t<range_nlr<advance_test_tree, contexts::tlist>>>
+        > &&
+        are_same_v<
+            accumulate_t<tree_reverse_range_t<level_test_tree, contexts::tlist, traversals::lr>>,
+            meta::tlist<tlist_leaf<4>, tlist_leaf<3>, tlist_leaf<2>, tlist_leaf<1>, tlist_leaf<0>>
+        > &&
+        are_same_v<
+            accumulate_t<tree_reverse_range_t<level_test_tree, contexts::tlist, traversals::nlr>>,
+            type_list::reverse<accumulate_t<range_nlr<level_test_tree, contexts::tlist>>>
+        > &&
+        are_same_v<
+            accumulate_t<tree_reverse_range_t<level_test_tree, contexts::tlist, traversals::lrn>>,
+            type_list::reverse<accumulate_t<range_lrn<level_test_tree, contexts::tlist>>>
+        > &&
+        are_same_v<
+            accumulate_t<tree_reverse_range_t<level_test_tree, indexed_tlist, traversals::level_order>>,
+            type_list::reverse<accumulate_t<range_bfs<level_test_tree, contexts::tlist>>>
+        > &&
+        are_same_v<
+            accumulate_t<tree_reverse_range_t<indexed_intrusive_tree, contexts::intrusive, traversals::lr>>,
+            meta::tlist<intrusive_leaf<2>, intrusive_leaf<1>, intrusive_leaf<0>>
+        >
+    );
+
+    //
+    // pruning traversal
+    //
+
+    // prunes the subtree below the second child of the root
+    template<typename Ctx, typename Path>
+    struct prune_second_subtree : std::bool_constant<
+        (type_list::size<Path> == 2) && std::is_same_v<type_list::back<Path>, tlist_tree<tlist_leaf<1>, tlist_tree<tlist_leaf<2>>>>
+    > {};
+
+    // prunes everything below depth 1
+    template<typename Ctx, typename Path>
+    struct prune_deeper_than_one : std::bool_constant<(type_list::size<Path> > 2)> {};
+
+    template<typename Ctx, typename Path>
+    struct prune_all : std::true_type {};
+
+    // the paths to the nodes asked for
+    template<typename Ctx, typename Path>
+    struct prune_leaf_3 : std::bool_constant<std::is_same_v<Path, meta::tlist<level_test_tree, tlist_tree<tlist_leaf<3>>, tlist_leaf<3>>>> {};
+
+    static_assert(
+        are_same_v<
+            accumulate_t<prune_range<level_test_tree, contexts::tlist, prune_second_subtree>>,
+            meta::tlist<level_test_tree, tlist_leaf<0>, tlist_tree<tlist_leaf<3>>, tlist_leaf<3>, tlist_leaf<4>>
+        > &&
+        are_same_v<
+            accumulate_t<prune_range<level_test_tree, contexts::tlist, prune_second_subtree, traversals::lr>>,
+            meta::tlist<tlist_leaf<0>, tlist_leaf<3>, tlist_leaf<4>>
+        > &&
+        are_same_v<
+            accumulate_t<prune_range<level_test_tree, indexed_tlist, prune_deeper_than_one>>,
+            meta::tlist<level_test_tree, tlist_leaf<0>, tlist_tree<tlist_leaf<1>, tlist_tree<tlist_leaf<2>>>, tlist_tree<tlist_leaf<3>>, tlist_leaf<4>>
+        > &&
+        are_same_v<
+            accumulate_t<prune_range<level_test_tree, contexts::tlist, prune_deeper_than_one, traversals::lr>>,
+            meta::tlist<tlist_leaf<0>, tlist_leaf<4>>
+        > &&
+        are_same_v<
+            accumulate_t<prune_range<level_test_tree, contexts::tlist, prune_leaf_3, traversals::lr>>,
+            meta::tlist<tlist_leaf<0>, tlist_leaf<1>, tlist_leaf<2>, tlist_leaf<4>>
+        > &&
+        are_same_v<
+            accumulate_t<prune_range<indexed_intrusive_tree, contexts::intrusive, prune_all>>,
+            meta::tlist<>
+        > &&
+        concepts::EmptyRange<prune_range<indexed_intrusive_tree, contexts::intrusive, prune_all>> &&
+        are_same_v<
+            path_t<advance_n_t<tree_begin<level_test_tree, contexts::tlist, traversals::pruned<prune_second_subtree, traversals::lr>>, 1>>,
+            meta::tlist<level_test_tree, tlist_tree<tlist_leaf<3>>, tlist_leaf<3>>
+        >
+    );
+
+    // pruned subtrees are never entered, the children of this one cannot be instantiated
+    template<typename Ctx, typename Path>
+    struct prune_unfinished : std::bool_constant<std::is_same_v<type_list::back<Path>, unfinished_tree>> {};
+
+    static_assert(
+        are_same_v<
+            accumulate_t<prune_range<intrusive_tree<intrusive_leaf<0>, unfinished_tree, intrusive_leaf<1>>, contexts::intrusive, prune_unfinished, traversals::lr>>,
+            meta::tlist<intrusive_leaf<0>, intrusive_leaf<1>>
+        >
+    );
+
+    //
+    // node_children_t, node_subtree_size_v, node_leaf_count_v, node_height_v
+    //
+
+    static_assert(
+        node_num_children_v<contexts::tlist, advance_test_tree> == 2 &&
+        are_same_v<node_get_child_t<contexts::tlist, advance_test_tree, 1>, tlist_leaf<2>> &&
+        are_same_v<
+            node_children_t<contexts::tlist, advance_test_tree>,
+            meta::tlist<tlist_tree<tlist_leaf<0>, tlist_leaf<1>>, tlist_leaf<2>>
+        > &&
+        are_same_v<node_children_t<contexts::tlist, tlist_leaf<0>>, meta::tlist<>> &&
+        node_subtree_size_v<contexts::tlist, advance_test_tree> == 5 &&
+        node_leaf_count_v<contexts::tlist, advance_test_tree> == 3 &&
+        node_height_v<contexts::tlist, advance_test_tree> == 2 &&
+        node_subtree_size_v<contexts::tlist, level_test_tree> == 9 &&
+        node_leaf_count_v<contexts::tlist, level_test_tree> == 5 &&
+        node_height_v<contexts::tlist, level_test_tree> == 3 &&
+        node_height_v<contexts::tlist, tlist_leaf<0>> == 0 &&
+        node_leaf_count_v<contexts::intrusive, indexed_intrusive_tree> == 3
+    );
+
+    //
+    // tree_stats
+    //
+
+    static_assert(
+        tree_stats<level_test_tree, contexts::tlist>::max_depth == 3 &&
+        tree_stats<level_test_tree, contexts::tlist>::node_count == 9 &&
+        tree_stats<level_test_tree, contexts::tlist>::leaf_count == 5 &&
+        are_same_v<tree_stats<level_test_tree, contexts::tlist>::level_widths, vlist<size_t, 1, 4, 3, 1>> &&
+        tree_stats<level_test_tree, contexts::tlist>::subtree_sizes == std::array<size_t, 9>{ 9, 1, 4, 1, 2, 1, 2, 1, 1 } &&
+        are_same_v<tree_stats<indexed_intrusive_tree, contexts::intrusive>::level_widths, vlist<size_t, 1, 2, 2>> &&
+        are_same_v<tree_stats<tlist_leaf<0>, contexts::tlist>::level_widths, vlist<size_t, 1>>
+    );
+
+    // the same figures as counting through traversals
+    static_assert(
+        tree_stats<level_test_tree, contexts::tlist>::node_count == type_list::size<accumulate_t<range_nlr<level_test_tree, contexts::tlist>>> &&
+        tree_stats<level_test_tree, contexts::tlist>::leaf_count == type_list::size<accumulate_t<range_lr<level_test_tree, contexts::tlist>>> &&
+        tree_stats<advance_test_tree, contexts::tlist>::subtree_sizes == tree_table<advance_test_tree, contexts::tlist>::subtree_size
+    );
+
+    //
+    // leaf index <-> index path
+    //
+
+    static_assert(
+        leaf_index_of_v<level_test_tree, contexts::tlist, vlist<size_t, 0>> == 0 &&
+        leaf_index_of_v<level_test_tree, contexts::tlist, vlist<size_t, 1, 0>> == 1 &&
+        leaf_index_of_v<level_test_tree, contexts::tlist, vlist<size_t, 1, 1, 0>> == 2 &&
+        leaf_index_of_v<level_test_tree, contexts::tlist, vlist<size_t, 2, 0>> == 3 &&
+        leaf_index_of_v<level_test_tree, contexts::tlist, vlist<size_t, 3>> == 4 &&
+        leaf_index_of_v<level_test_tree, contexts::tlist, vlist<size_t, 2>> == 3 &&
+        leaf_index_of_v<level_test_tree, contexts::tlist, vlist<size_t>> == 0 &&
+        leaf_index_of_v<indexed_intrusive_tree, contexts::intrusive, vlist<size_t, 0, 1>> == 1
+    );
+
+    static_assert(
+        are_same_v<leaf_path_of_t<level_test_tree, contexts::tlist, 0>, vlist<size_t, 0>> &&
+        are_same_v<leaf_path_of_t<level_test_tree, contexts::tlist, 2>, vlist<size_t, 1, 1, 0>> &&
+        are_same_v<leaf_path_of_t<level_test_tree, contexts::tlist, 3>, vlist<size_t, 2, 0>> &&
+        are_same_v<leaf_path_of_t<level_test_tree, contexts::tlist, 4>, vlist<size_t, 3>> &&
+        are_same_v<leaf_path_of_t<indexed_intrusive_tree, contexts::intrusive, 2>, vlist<size_t, 1>> &&
+        are_same_v<leaf_path_of_t<tlist_leaf<0>, contexts::tlist, 0>, vlist<size_t>>
+    );
+
+    // past the last leaf there is no path
+    template<typename Root, typename Ctx, size_t N>
+    concept has_leaf_path = requires { typename leaf_path_of_t<Root, Ctx, N>; };
+
+    static_assert(has_leaf_path<level_test_tree, contexts::tlist, 4> && !has_leaf_path<level_test_tree, contexts::tlist, 5>);
+
+    // the paths lead to the leaves the lr traversal visits at those indices
+    static_assert(
+        are_same_v<
+            detail::node_at_indices<contexts::tlist, level_test_tree, leaf_path_of_t<level_test_tree, contexts::tlist, 3>>::type,
+            dereference_t<advance_n_t<tree_begin<level_test_tree, contexts::tlist, traversals::lr>, 3>>
+        > &&
+        leaf_index_of_v<level_test_tree, contexts::tlist, leaf_path_of_t<level_test_tree, contexts::tlist, 1>> == 1
+    );
+
+    static_assert(
+        leaf_index_of_type_v<level_test_tree, contexts::tlist, tlist_leaf<2>> == 2 &&
+        leaf_index_of_type_v<level_test_tree, contexts::tlist, tlist_leaf<4>> == 4 &&
+        leaf_index_of_type_v<level_test_tree, contexts::tlist, tlist_leaf<5>> == 5 &&
+        leaf_index_of_type_v<tlist_tree<tlist_leaf<1>, tlist_tree<tlist_leaf<0>, tlist_leaf<1>>>, contexts::tlist, tlist_leaf<1>> == 0 &&
+        leaf_index_of_type_v<indexed_intrusive_tree, contexts::intrusive, intrusive_leaf<2>> == 2
+    );
+
+    //
+    // tree_table and the random access traversals
+    //
+
+    using advance_test_table = tree_table<advance_test_tree, contexts::tlist>;
+
+    static_assert(
+        are_same_v<
+            advance_test_table::nodes,
+            accumulate_t<range_nlr<advance_test_tree, contexts::tlist>>
+        > &&
+        advance_test_table::num_children == std::array<size_t, 5>{ 2, 2, 0, 0, 0 } &&
+        advance_test_table::depth        == std::array<size_t, 5>{ 0, 1, 2, 2, 1 } &&
+        advance_test_table::parent       == std::array<size_t, 5>{ advance_test_table::no_parent, 0, 1, 1, 0 } &&
+        advance_test_table::child_index  == std::array<size_t, 5>{ 0, 0, 0, 1, 1 } &&
+        advance_test_table::subtree_size == std::array<size_t, 5>{ 5, 3, 1, 1, 1 } &&
+        advance_test_table::leaves       == std::array<size_t, 3>{ 2, 3, 4 } &&
+        advance_test_table::leaf_rank    == std::array<size_t, 5>{ 3, 3, 0, 1, 2 } &&
+        advance_test_table::child(0, 1) == 4 &&
+        are_same_v<advance_test_table::node<3>, tlist_leaf<1>>
+    );
+
+    using random_nlr = traversals::random_access<traversals::nlr>;
+    using random_lr  = traversals::random_access<traversals::lr>;
+
+    // the same sequences as the stepwise traversals
+    static_assert(
+        are_same_v<
+            accumulate_t<tree_range_t<advance_test_tree, contexts::tlist, random_nlr>>,
+            accumulate_t<range_nlr<advance_test_tree, contexts::tlist>>
+        > &&
+        are_same_v<
+            accumulate_t<tree_range_t<advance_test_tree, contexts::tlist, random_lr>>,
+            accumulate_t<range_lr<advance_test_tree, contexts::tlist>>
+        > &&
+        are_same_v<
+            accumulate_t<tree_range_t<indexed_intrusive_tree, contexts::intrusive, random_lr>>,
+            meta::tlist<intrusive_leaf<0>, intrusive_leaf<1>, intrusive_leaf<2>>
+        >
+    );
+
+    // advance_n jumps, also to the end and on ranges
+    static_assert(
+        are_same_v<dereference_t<advance_n_t<tree_begin<advance_test_tree, contexts::tlist, random_nlr>, 3>>, tlist_leaf<1>> &&
+        are_same_v<dereference_t<advance_n_t<tree_begin<advance_test_tree, contexts::tlist, random_lr>, 2>>, tlist_leaf<2>> &&
+        are_same_v<
+            advance_n_t<tree_begin<advance_test_tree, contexts::tlist, random_nlr>, 5>,
+            advance_t<advance_n_t<tree_begin<advance_test_tree, contexts::tlist, random_nlr>, 4>>,
+            tree_end<advance_test_tree, contexts::tlist, random_nlr>
+        > &&
+        are_same_v<
+            advance_n_t<tree_begin<advance_test_tree, contexts::tlist, random_lr>, 3>,
+            tree_end<advance_test_tree, contexts::tlist, random_lr>
+        > &&
+        are_same_v<
+            dereference_t<advance_n_t<tree_range_t<advance_test_tree, contexts::tlist, random_lr>, 1>>,
+            tlist_leaf<1>
+        > &&
+        are_same_v<
+            advance_n_t<tree_range_t<advance_test_tree, contexts::tlist, random_lr>, 3>,
+            iterator_range<tree_end<advance_test_tree, contexts::tlist, random_lr>, tree_end<advance_test_tree, contexts::tlist, random_lr>>
+        >
+    );
+
+    // paths, distance and order
+    static_assert(
+        are_same_v<
+            path_t<advance_n_t<tree_begin<advance_test_tree, contexts::tlist, random_nlr>, 3>>,
+            path_t<advance_n_t<tree_begin<advance_test_tree, contexts::tlist>, 3>>
+        > &&
+        iterator_distance_v<
+            advance_n_t<tree_begin<advance_test_tree, contexts::tlist, random_lr>, 1>,
+            tree_end<advance_test_tree, contexts::tlist, random_lr>
+        > == 2 &&
+        iterator_distance_v<tree_range_t<advance_test_tree, contexts::tlist, random_nlr>, tree_end<advance_test_tree, contexts::tlist, random_nlr>> == 5 &&
+        iterator_distance_v<tree_begin<advance_test_tree, contexts::tlist>, tree_end<advance_test_tree, contexts::tlist>> == 5 &&
+        iterator_less_v<
+            tree_begin<advance_test_tree, contexts::tlist, random_nlr>,
+            advance_n_t<tree_begin<advance_test_tree, contexts::tlist, random_nlr>, 2>
+        > &&
+        !iterator_less_v<
+            tree_end<advance_test_tree, contexts::tlist, random_lr>,
+            tree_begin<advance_test_tree, contexts::tlist, random_lr>
+        > &&
+        !concepts::RandomAccessIterator<tree_begin<advance_test_tree, contexts::tlist>>
+    );
+
+    // retreat, also from the end and backwards as a range
+    static_assert(
+        are_same_v<retreat_n_t<tree_end<advance_test_tree, contexts::tlist, random_lr>, 3>, tree_begin<advance_test_tree, contexts::tlist, random_lr>> &&
+        are_same_v<dereference_t<retreat_n_t<advance_n_t<tree_begin<advance_test_tree, contexts::tlist, random_nlr>, 4>, 2>>, tlist_leaf<0>> &&
+        are_same_v<
+            accumulate_t<tree_reverse_range_t<advance_test_tree, contexts::tlist, random_lr>>,
+            meta::tlist<tlist_leaf<2>, tlist_leaf<1>, tlist_leaf<0>>
+        >
+    );
+
+    //
+    // flatten_tree
+    //
+
+    template<typename Node>
+    struct flat_leaf_id : std::integral_constant<int, -1> {};
+
+    template<size_t Index>
+    struct flat_leaf_id<tlist_leaf<Index>> : std::integral_constant<int, static_cast<int>(Index)> {};
+
+    // value, depth, parent, first child, number of children, subtree end
+    static_assert(
+        flatten_tree_v<level_test_tree, contexts::tlist, traversals::nlr, flat_leaf_id> == std::array<flat_node<int, std::uint8_t>, 9>{{
+            { -1, 0, 9, 1, 4, 9 },
+            {  0, 1, 0, 2, 0, 2 },
+            { -1, 1, 0, 3, 2, 6 },
+            {  1, 2, 2, 4, 0, 4 },
+            { -1, 2, 2, 5, 1, 6 },
+            {  2, 3, 4, 6, 0, 6 },
+            { -1, 1, 0, 7, 1, 8 },
+            {  3, 2, 6, 8, 0, 8 },
+            {  4, 1, 0, 9, 0, 9 }
+        }}
+    );
+
+    // the children stay adjacent, the subtrees do not and have no end
+    static_assert(
+        flatten_tree_v<level_test_tree, contexts::tlist, traversals::level_order, flat_leaf_id> == std::array<flat_level_node<int, std::uint8_t>, 9>{{
+            { -1, 0, 9, 1, 4 },
+            {  0, 1, 0, 5, 0 },
+            { -1, 1, 0, 5, 2 },
+            { -1, 1, 0, 7, 1 },
+            {  4, 1, 0, 8, 0 },
+            {  1, 2, 2, 8, 0 },
+            { -1, 2, 2, 8, 1 },
+            {  3, 2, 3, 9, 0 },
+            {  2, 3, 6, 9, 0 }
+        }}
+    );
+
+    template<typename Indices>
+    struct wide_tlist_tree;
+
+    template<size_t... Is>
+    struct wide_tlist_tree<std::index_sequence<Is...>>
+    {
+        using type = meta::tlist<tlist_leaf<Is>...>;
+    };
+
+    // the indices in the smallest type that holds the table size
+    static_assert(
+        are_same_v<flatten_tree<wide_tlist_tree<std::make_index_sequence<300>>::type, contexts::tlist, traversals::nlr, flat_leaf_id>::index_type, std::uint16_t> &&
+        sizeof(flatten_tree<level_test_tree, contexts::tlist, traversals::nlr, flat_leaf_id>::record) == 12
+    );
+
+    template<typename Node>
+    struct intrusive_leaf_count : std::integral_constant<size_t, node_leaf_count_v<contexts::intrusive, Node>> {};
+
+    static_assert(
+        flatten_tree<indexed_intrusive_tree, contexts::intrusive, traversals::nlr, intrusive_leaf_count>::size == 5 &&
+        flatten_tree_v<indexed_intrusive_tree, contexts::intrusive, traversals::nlr, intrusive_leaf_count>[1].value == 2 &&
+        flatten_tree_v<indexed_intrusive_tree, contexts::intrusive, traversals::nlr, intrusive_leaf_count>[4].parent == 0
+    );
+
+    //
+    // for_each_node
+    //
+
+    // the leaf id and depth of every node as visited, the index paths lead to the nodes visited
+    template<typename Range, typename Root, typename Ctx>
+    constexpr std::array<std::pair<int, size_t>, 9> visited_nodes()
+    {
+        std::array<std::pair<int, size_t>, 9> result{};
+        size_t count = 0;
+        for_each_node(Range{}, [&](auto node, auto depth, auto path) {
+            static_assert(are_same_v<typename detail::node_at_indices<Ctx, Root, decltype(path)>::type, typename decltype(node)::type>);
+            static_assert(value_list::size<decltype(path)> == depth);
+            result[count++] = { flat_leaf_id<typename decltype(node)::type>::value, depth };
+        });
+        return result;
+    }
+
+    template<typename Range>
+    constexpr auto visited_nlr = visited_nodes<Range, level_test_tree, contexts::tlist>();
+
+    template<typename Record>
+    constexpr bool same_as_flattened(const std::array<std::pair<int, size_t>, 9>& visited, const std::array<Record, 9>& flattened)
+    {
+        for(size_t i = 0; i < 9; ++i) {
+            if(visited[i].first != flattened[i].value || visited[i].second != flattened[i].depth) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(
+        same_as_flattened(visited_nlr<range_nlr<level_test_tree, contexts::tlist>>, flatten_tree_v<level_test_tree, contexts::tlist, traversals::nlr, flat_leaf_id>) &&
+        same_as_flattened(visited_nlr<range_bfs<level_test_tree, contexts::tlist>>, flatten_tree_v<level_test_tree, contexts::tlist, traversals::level_order, flat_leaf_id>) &&
+        same_as_flattened(visited_nlr<tree_range_t<level_test_tree, contexts::tlist, random_nlr>>, flatten_tree_v<level_test_tree, contexts::tlist, traversals::nlr, flat_leaf_id>) &&
+        visited_nodes<range_nlr<level_test_tree, contexts::indexed<contexts::tlist>>, level_test_tree, contexts::tlist>() == visited_nlr<range_nlr<level_test_tree, contexts::tlist>>
+    );
+
+    // the leaf paths in leaf order
+    constexpr bool leaf_paths_in_order()
+    {
+        size_t count = 0;
+        bool   ok    = true;
+        for_each_node(range_lr<level_test_tree, contexts::tlist>{}, [&](auto, auto, auto path) {
+            ok = ok && leaf_index_of_v<level_test_tree, contexts::tlist, decltype(path)> == count++;
+        });
+        return ok && count == 5;
+    }
+
+    static_assert(leaf_paths_in_order());
+
+    // early exit, the number of calls made
+    template<typename Leaf>
+    constexpr std::pair<bool, size_t> calls_until()
+    {
+        size_t calls = 0;
+        const bool found = for_each_node_until(range_lr<level_test_tree, contexts::tlist>{}, [&](auto node, auto, auto) {
+            ++calls;
+            return are_same_v<typename decltype(node)::type, Leaf>;
+        });
+        return { found, calls };
+    }
+
+    template<typename Range>
+    concept node_visitable = requires { for_each_node(Range{}, [](auto, auto, auto) {}); };
+
+    // tree ranges only, a range that visits no node included
+    static_assert(
+        node_visitable<range_lr<level_test_tree, contexts::tlist>> &&
+        node_visitable<iterator_range<tree_end<level_test_tree, contexts::tlist>, tree_end<level_test_tree, contexts::tlist>>> &&
+        !node_visitable<common::iterator_range<common::iterator<meta::tlist<int, char>, 0>, common::iterator<meta::tlist<int, char>, 1>>>
+    );
+
+    static_assert(
+        calls_until<tlist_leaf<2>>() == std::pair<bool, size_t>{ true, 3 } &&
+        calls_until<tlist_leaf<0>>() == std::pair<bool, size_t>{ true, 1 } &&
+        calls_until<tlist_leaf<5>>() == std::pair<bool, size_t>{ false, 5 }
+    );
+
+    //
+    // tree_dispatch
+    //
+
+    template<tree_dispatch_mode Mode, typename... Steps>
+    constexpr int level_test_leaf(Steps... steps)
+    {
+        const std::array<std::uint8_t, sizeof...(Steps)> path = { static_cast<std::uint8_t>(steps)... };
+        return tree_dispatch<level_test_tree, contexts::tlist, Mode>(
+            path, []<typename Leaf>() { return flat_leaf_id<Leaf>::value; }, [] { return -2; });
+    }
+
+    // paths to inner nodes, past the leaves and to children a node does not have miss
+    template<tree_dispatch_mode Mode>
+    constexpr bool dispatches_level_test_tree()
+    {
+        return
+            level_test_leaf<Mode>(0) == 0 && level_test_leaf<Mode>(1, 0) == 1 && level_test_leaf<Mode>(1, 1, 0) == 2 &&
+            level_test_leaf<Mode>(2, 0) == 3 && level_test_leaf<Mode>(3) == 4 &&
+            level_test_leaf<Mode>() == -2 && level_test_leaf<Mode>(1, 1) == -2 && level_test_leaf<Mode>(4) == -2 &&
+            level_test_leaf<Mode>(0, 0) == -2 && level_test_leaf<Mode>(1, 1, 0, 0) == -2 && level_test_leaf<Mode>(1, 5, 0) == -2 &&
+            level_test_leaf<Mode>(2, 1) == -2 && level_test_leaf<Mode>(255) == -2;
+    }
+
+    static_assert(
+        dispatches_level_test_tree<tree_dispatch_mode::automatic>() &&
+        dispatches_level_test_tree<tree_dispatch_mode::jump_tables>() &&
+        dispatches_level_test_tree<tree_dispatch_mode::flattened>()
+    );
+
+    // a leaf and the rest of the chain below every inner node
+    template<size_t Depth>
+    struct chain_tree : std::type_identity<intrusive_tree<intrusive_leaf<Depth>, typename chain_tree<Depth - 1>::type>> {};
+
+    template<>
+    struct chain_tree<0> : std::type_identity<intrusive_leaf<0>> {};
+
+    constexpr size_t chain_leaf(std::span<const int> path)
+    {
+        return tree_dispatch<chain_tree<16>::type>(
+            path, []<typename Leaf>() { return leaf_index_of_type_v<chain_tree<16>::type, contexts::intrusive, Leaf>; }, [] { return size_t(100); });
+    }
+
+    template<typename Root, tree_dispatch_mode Mode, typename Path = std::span<const int>>
+    concept tree_dispatchable = requires(Path path) {
+        tree_dispatch<Root, contexts::intrusive, Mode>(path, []<typename Leaf>() {}, [] {});
+    };
+
+
+    // too deep to be flattened, the signed path elements below zero miss
+    static_assert(
+        !detail::tree_dispatcher<chain_tree<16>::type, contexts::intrusive>::small &&
+        tree_dispatchable<chain_tree<16>::type, tree_dispatch_mode::jump_tables> &&
+        !tree_dispatchable<chain_tree<16>::type, tree_dispatch_mode::flattened> &&
+        tree_dispatchable<indexed_intrusive_tree, tree_dispatch_mode::flattened> &&
+        chain_leaf(std::array{ 0 }) == 0 &&
+        chain_leaf(std::array{ 1, 1, 1, 0 }) == 3 &&
+        chain_leaf(std::array{ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 }) == 16 &&
+        chain_leaf(std::array{ 1, -1 }) == 100 &&
+        chain_leaf(std::array{ 2 }) == 100
+    );
+
+    // any contiguous range of integers is a path
+    static_assert(
+        tree_dispatchable<chain_tree<16>::type, tree_dispatch_mode::jump_tables, std::array<std::uint8_t, 2>> &&
+        tree_dispatchable<chain_tree<16>::type, tree_dispatch_mode::jump_tables, std::span<std::uint8_t>> &&
+        tree_dispatchable<chain_tree<16>::type, tree_dispatch_mode::jump_tables, const short (&)[3]> &&
+        !tree_dispatchable<chain_tree<16>::type, tree_dispatch_mode::jump_tables, std::span<const float>>
+    );
+
+    //
+    // to_array of an accumulated leaf list, shared with the value list of the same values
+    //
+
+    template<typename Leaf>
+    struct leaf_id;
+
+    template<size_t Index>
+    struct leaf_id<tlist_leaf<Index>> : std::integral_constant<size_t, 10 * Index> {};
+
+    static_assert(
+        type_list::to_array<accumulate_t<range_lr<advance_test_tree, contexts::tlist>>, leaf_id> ==
+            std::array<size_t, 3>{ 0, 10, 20 } &&
+        &type_list::to_array<accumulate_t<range_lr<advance_test_tree, contexts::tlist>>, leaf_id> ==
+            &value_list::to_array<vlist<size_t, 0, 10, 20>> &&
+        type_list::to_array<accumulate_t<range_lr<advance_test_tree, contexts::tlist>>, leaf_id, int>[2] == 20
+    );
+
 }
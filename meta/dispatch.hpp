@@ -0,0 +1,259 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef META_DISPATCH_HPP___
+#define META_DISPATCH_HPP___
+
+#include <meta/tlist.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace meta {
+
+    namespace detail {
+
+        template<typename F, typename T>
+        using dispatch_result_t = decltype(std::declval<F&>().template operator()<T>());
+
+        template<typename T, typename F>
+        constexpr dispatch_result_t<F, T> dispatch_call(F& f)
+        {
+            return f.template operator()<T>();
+        }
+
+        // the result of f for the first element, uniform if f returns it for every element
+        template<concepts::TypeList List, typename F>
+        struct dispatch_result;
+
+        template<template<typename...> typename XList, typename T, typename... Ts, typename F>
+        struct dispatch_result<XList<T, Ts...>, F>
+        {
+            using type = dispatch_result_t<F, T>;
+
+            static constexpr bool uniform = (std::is_same_v<type, dispatch_result_t<F, Ts>> && ...);
+        };
+
+        template<concepts::TypeList List, typename F>
+        struct dispatch_table;
+
+        template<template<typename...> typename XList, typename... Ts, typename F>
+        struct dispatch_table<XList<Ts...>, F>
+        {
+            using result = typename dispatch_result<XList<Ts...>, F>::type;
+
+            static constexpr std::array<result (*)(F&), sizeof...(Ts)> value = { &dispatch_call<Ts, F>... };
+        };
+
+        // lists up to this size are dispatched with a chain of compares, which lets the compiler inline the calls
+        static constexpr size_t dispatch_chain_size = 8;
+
+        // dispatch does not check the index, both paths let the compiler assume it is in range
+        [[noreturn]] constexpr void dispatch_out_of_range()
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            __assume(false);
+#else
+            __builtin_unreachable();
+#endif
+        }
+
+        // one case per element of the list
+        template<concepts::TypeList List, typename F>
+        constexpr typename dispatch_result<List, F>::type dispatch_cases(size_t, F&, std::index_sequence<>)
+        {
+            dispatch_out_of_range();
+        }
+
+        template<concepts::TypeList List, typename F, size_t I, size_t... Is>
+        constexpr typename dispatch_result<List, F>::type dispatch_cases(size_t index, F& f, std::index_sequence<I, Is...>)
+        {
+            if(index == I) {
+                return dispatch_call<type_list::get<List, I>>(f);
+            }
+            return dispatch_cases<List>(index, f, std::index_sequence<Is...>());
+        }
+
+    }
+
+    //
+    // dispatch< List >( index, f )
+    // Runtime dispatch over a type list: calls f.template operator()<T>() for the T at index in List and returns its
+    // result, which must be of the same type for every T. index must be less than the size of the list, it is not
+    // checked. Small lists are a compare per element, larger ones an indirect call through one constexpr table of
+    // function pointers per list and F, neither throws, f.e.
+    //     dispatch<tlist<ping, data, close>>(header.kind, [&]<typename Packet>() { handle<Packet>(buffer); });
+    //
+    template<concepts::TypeList List, typename F>
+    requires(type_list::size<List> > 0 && detail::dispatch_result<List, std::remove_reference_t<F>>::uniform)
+    constexpr typename detail::dispatch_result<List, std::remove_reference_t<F>>::type dispatch(size_t index, F&& f)
+    {
+        if constexpr(type_list::size<List> <= detail::dispatch_chain_size) {
+            return detail::dispatch_cases<List>(index, f, std::make_index_sequence<type_list::size<List>>());
+        } else {
+            if(index >= type_list::size<List>) {
+                detail::dispatch_out_of_range();
+            }
+            return detail::dispatch_table<List, std::remove_reference_t<F>>::value[index](f);
+        }
+    }
+
+    namespace detail {
+
+        template<typename F, typename A, typename B>
+        using dispatch2_result_t = decltype(std::declval<F&>().template operator()<A, B>());
+
+        template<typename A, typename B, typename F>
+        constexpr dispatch2_result_t<F, A, B> dispatch2_call(F& f)
+        {
+            return f.template operator()<A, B>();
+        }
+
+        template<typename A, typename B>
+        struct allow_all_pairs : std::true_type
+        {};
+
+        //
+        // dispatch2_cells< ListA, ListB, Symmetric, Allowed >
+        // The pairs a dispatch2 table holds, as row major indices into the ListA x ListB matrix: those Allowed, of
+        // symmetric tables only those with ia <= ib. slots maps every cell of the matrix to 1 + its position among the
+        // held ones, 0 if it is not held.
+        //
+        template<
+            concepts::TypeList ListA, concepts::TypeList ListB, bool Symmetric, template<typename, typename> typename Allowed,
+            typename Cells = std::make_index_sequence<type_list::size<ListA> * type_list::size<ListB>>
+        >
+        struct dispatch2_cells;
+
+        template<
+            concepts::TypeList ListA, concepts::TypeList ListB, bool Symmetric, template<typename, typename> typename Allowed,
+            size_t... Cells
+        >
+        struct dispatch2_cells<ListA, ListB, Symmetric, Allowed, std::index_sequence<Cells...>>
+        {
+            static constexpr size_t columns = type_list::size<ListB>;
+
+            static constexpr std::array<bool, sizeof...(Cells)> held = {
+                ((!Symmetric || Cells / columns <= Cells % columns) &&
+                 Allowed<type_list::get<ListA, Cells / columns>, type_list::get<ListB, Cells % columns>>::value)...
+            };
+
+            static constexpr size_t count = static_cast<size_t>(std::count(held.begin(), held.end(), true));
+
+            static constexpr std::array<size_t, count> cells = [] {
+                std::array<size_t, count> result{};
+                for(size_t cell = 0, k = 0; cell < held.size(); ++cell) {
+                    if(held[cell]) {
+                        result[k++] = cell;
+                    }
+                }
+                return result;
+            }();
+
+            static constexpr std::array<smallest_unsigned_t<count>, sizeof...(Cells)> slots = [] {
+                std::array<smallest_unsigned_t<count>, sizeof...(Cells)> result{};
+                for(size_t k = 0; k < count; ++k) {
+                    result[cells[k]] = static_cast<smallest_unsigned_t<count>>(k + 1);
+                }
+                return result;
+            }();
+
+            template<size_t K>
+            using first = type_list::get<ListA, cells[K] / columns>;
+
+            template<size_t K>
+            using second = type_list::get<ListB, cells[K] % columns>;
+        };
+
+        template<typename Cells, typename F, typename Ks = std::make_index_sequence<Cells::count>>
+        struct dispatch2_table;
+
+        template<typename Cells, typename F, size_t K, size_t... Ks>
+        struct dispatch2_table<Cells, F, std::index_sequence<K, Ks...>>
+        {
+            using result = dispatch2_result_t<F, typename Cells::template first<K>, typename Cells::template second<K>>;
+
+            static constexpr bool uniform =
+                (std::is_same_v<result, dispatch2_result_t<F, typename Cells::template first<Ks>, typename Cells::template second<Ks>>> && ...);
+
+            static constexpr std::array<result (*)(F&), Cells::count> value = {
+                &dispatch2_call<typename Cells::template first<K>, typename Cells::template second<K>, F>,
+                &dispatch2_call<typename Cells::template first<Ks>, typename Cells::template second<Ks>, F>...
+            };
+        };
+
+        template<concepts::TypeList ListA, concepts::TypeList ListB, bool Symmetric, template<typename, typename> typename Allowed, typename F>
+        using dispatch2_table_t = dispatch2_table<dispatch2_cells<ListA, ListB, Symmetric, Allowed>, std::remove_reference_t<F>>;
+
+    }
+
+    //
+    // dispatch2< ListA, ListB >( ia, ib, f )
+    // Double dispatch: calls f.template operator()<A, B>() for the A at ia in ListA and the B at ib in ListB through
+    // one flat constexpr table of function pointers, ia * size<ListB> + ib, of all pairs. The results must be of the
+    // same type for all pairs, the indices less than the list sizes, f.e.
+    //     dispatch2<shapes, shapes>(lhs.kind, rhs.kind, [&]<typename Lhs, typename Rhs>() { return collide<Lhs, Rhs>(lhs, rhs); });
+    //
+    // dispatch2< ListA, ListB, Allowed >( ia, ib, f, miss )
+    // Only the pairs for which Allowed<A, B>::value holds are instantiated and held in the table, which a matrix of
+    // small slot numbers indexes. miss() is called for the others.
+    //
+    // dispatch2_symmetric< List >( ia, ib, f ), dispatch2_symmetric< List, Allowed >( ia, ib, f, miss )
+    // For symmetric f, like dispatch2< List, List >: the table holds each unordered pair once, f is called with the
+    // types in list order, ie. for (ib, ia) if ia > ib.
+    //
+    template<concepts::TypeList ListA, concepts::TypeList ListB, typename F>
+    requires(type_list::size<ListA> > 0 && type_list::size<ListB> > 0 && detail::dispatch2_table_t<ListA, ListB, false, detail::allow_all_pairs, F>::uniform)
+    constexpr typename detail::dispatch2_table_t<ListA, ListB, false, detail::allow_all_pairs, F>::result dispatch2(size_t ia, size_t ib, F&& f)
+    {
+        return detail::dispatch2_table_t<ListA, ListB, false, detail::allow_all_pairs, F>::value[ia * type_list::size<ListB> + ib](f);
+    }
+
+    template<concepts::TypeList ListA, concepts::TypeList ListB, template<typename, typename> typename Allowed, typename F, typename Miss>
+    requires(detail::dispatch2_cells<ListA, ListB, false, Allowed>::count > 0 && detail::dispatch2_table_t<ListA, ListB, false, Allowed, F>::uniform)
+    constexpr typename detail::dispatch2_table_t<ListA, ListB, false, Allowed, F>::result dispatch2(size_t ia, size_t ib, F&& f, Miss&& miss)
+    {
+        static_assert(
+            std::is_same_v<std::invoke_result_t<Miss&>, typename detail::dispatch2_table_t<ListA, ListB, false, Allowed, F>::result>,
+            "dispatch2: miss() must return the result type of f"
+        );
+
+        const size_t slot = detail::dispatch2_cells<ListA, ListB, false, Allowed>::slots[ia * type_list::size<ListB> + ib];
+        if(slot != 0) {
+            return detail::dispatch2_table_t<ListA, ListB, false, Allowed, F>::value[slot - 1](f);
+        }
+        return miss();
+    }
+
+    template<concepts::TypeList List, typename F>
+    requires(type_list::size<List> > 0 && detail::dispatch2_table_t<List, List, true, detail::allow_all_pairs, F>::uniform)
+    constexpr typename detail::dispatch2_table_t<List, List, true, detail::allow_all_pairs, F>::result dispatch2_symmetric(size_t ia, size_t ib, F&& f)
+    {
+        const size_t slot = detail::dispatch2_cells<List, List, true, detail::allow_all_pairs>::slots[std::min(ia, ib) * type_list::size<List> + std::max(ia, ib)];
+        return detail::dispatch2_table_t<List, List, true, detail::allow_all_pairs, F>::value[slot - 1](f);
+    }
+
+    template<concepts::TypeList List, template<typename, typename> typename Allowed, typename F, typename Miss>
+    requires(detail::dispatch2_cells<List, List, true, Allowed>::count > 0 && detail::dispatch2_table_t<List, List, true, Allowed, F>::uniform)
+    constexpr typename detail::dispatch2_table_t<List, List, true, Allowed, F>::result dispatch2_symmetric(size_t ia, size_t ib, F&& f, Miss&& miss)
+    {
+        static_assert(
+            std::is_same_v<std::invoke_result_t<Miss&>, typename detail::dispatch2_table_t<List, List, true, Allowed, F>::result>,
+            "dispatch2_symmetric: miss() must return the result type of f"
+        );
+
+        const size_t slot = detail::dispatch2_cells<List, List, true, Allowed>::slots[std::min(ia, ib) * type_list::size<List> + std::max(ia, ib)];
+        if(slot != 0) {
+            return detail::dispatch2_table_t<List, List, true, Allowed, F>::value[slot - 1](f);
+        }
+        return miss();
+    }
+
+}
+
+#endif
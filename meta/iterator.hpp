@@ -1,6 +1,7 @@
 #ifndef META_ITERATOR_HPP__
 #define META_ITERATOR_HPP__
 
+#include <concepts>
 #include <type_traits>
 
 namespace meta {
@@ -60,6 +61,43 @@ namespace meta {
     template<concepts::Iterator Iter, size_t N>
     using advance_n_t = typename advance_n<Iter, N>::type;
 
+    //
+    // retreat / retreat_n
+    // details: One step back. Bidirectional iterators specialize retreat, including their end sentinel, which retreats
+    //          to the last element. The first element has no predecessor (no ::type).
+    //
+
+    template<concepts::Iterator Iter>
+    struct retreat
+    {};
+
+    template<concepts::Iterator Iter>
+    using retreat_t = typename retreat<Iter>::type;
+
+    namespace concepts {
+
+        template<typename Iter>
+        concept BidirectionalIterator = Iterator<Iter> && requires() {
+            typename retreat<Iter>::type;
+        };
+
+    }
+
+    template<concepts::Iterator Iter, size_t N>
+    struct retreat_n
+    {
+        using type = typename retreat_n<retreat_t<Iter>, N-1>::type;
+    };
+
+    template<concepts::Iterator Iter>
+    struct retreat_n<Iter, 0>
+    {
+        using type = Iter;
+    };
+
+    template<concepts::Iterator Iter, size_t N>
+    using retreat_n_t = typename retreat_n<Iter, N>::type;
+
 
     //
     // transform_iterator
@@ -91,6 +129,56 @@ namespace meta {
     template<concepts::Iterator Iter1, concepts::Iterator Iter2>
     static constexpr bool iterator_equal_v = decltype(iterator_equal(std::declval<Iter1>(), std::declval<Iter2>()))::value;
 
+    //
+    // iterator_position
+    // details: Random access iterators (f.e. those of traversals::random_access) specialize this with the index of the
+    //          iterator in its sequence (the length for the end sentinel) and advance_n with a direct jump. Distance
+    //          and order then are a subtraction and a comparison.
+    //
+
+    template<typename Iter>
+    struct iterator_position
+    {};
+
+    namespace concepts {
+
+        template<typename Iter>
+        concept RandomAccessIterator = Iterator<Iter> && requires() {
+            { iterator_position<Iter>::value } -> std::convertible_to<size_t>;
+        };
+
+    }
+
+    //
+    // iterator_distance
+    // number of advance steps from From to To, To must be reachable from From
+    //
+
+    template<concepts::Iterator From, concepts::Iterator To>
+    struct iterator_distance
+    {
+        static constexpr size_t value = 1 + iterator_distance<advance_t<From>, To>::value;
+    };
+
+    template<concepts::Iterator Iter>
+    struct iterator_distance<Iter, Iter>
+    {
+        static constexpr size_t value = 0;
+    };
+
+    template<concepts::RandomAccessIterator From, concepts::RandomAccessIterator To>
+    requires(!std::is_same_v<From, To>)
+    struct iterator_distance<From, To>
+    {
+        static constexpr size_t value = iterator_position<To>::value - iterator_position<From>::value;
+    };
+
+    template<concepts::Iterator From, concepts::Iterator To>
+    static constexpr size_t iterator_distance_v = iterator_distance<From, To>::value;
+
+    template<concepts::RandomAccessIterator Iter1, concepts::RandomAccessIterator Iter2>
+    static constexpr bool iterator_less_v = (iterator_position<Iter1>::value < iterator_position<Iter2>::value);
+
     //
     // filter_iterator
     //
@@ -0,0 +1,277 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef META_KEYWORD_HPP___
+#define META_KEYWORD_HPP___
+
+#include <meta/tlist.hpp>
+#include <meta/dispatch.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace meta {
+
+    //
+    // fixed_string< N >
+    // A string literal as a structural type, so it can be a template argument: fixed_string{ "get" } holds the 3
+    // characters and the terminating zero.
+    //
+    template<size_t N>
+    struct fixed_string
+    {
+        char chars[N]{};
+
+        constexpr fixed_string(const char (&literal)[N])
+        {
+            std::copy_n(literal, N, chars);
+        }
+
+        static constexpr size_t size()
+        {
+            return N - 1;
+        }
+
+        constexpr std::string_view view() const
+        {
+            return std::string_view(chars, N - 1);
+        }
+    };
+
+    //
+    // keyword< String >, keywords< Strings... >
+    // A keyword is a type, so a keyword set is a plain type list, f.e. keywords<"get", "set", "del"> is
+    // tlist<keyword<"get">, keyword<"set">, keyword<"del">>.
+    //
+    template<fixed_string String>
+    struct keyword
+    {
+        static constexpr std::string_view value = String.view();
+    };
+
+    template<fixed_string... Strings>
+    using keywords = meta::tlist<keyword<Strings>...>;
+
+    namespace detail {
+
+        template<typename T>
+        struct is_keyword : std::false_type
+        {
+        };
+
+        template<fixed_string String>
+        struct is_keyword<keyword<String>> : std::true_type
+        {
+        };
+
+        template<concepts::TypeList List>
+        struct all_keywords;
+
+        template<template<typename...> typename XList, typename... Ts>
+        struct all_keywords<XList<Ts...>> : std::bool_constant<(is_keyword<Ts>::value && ...)>
+        {
+        };
+
+    }
+
+    namespace concepts {
+        // a type list of keyword<...> only, like keywords<...>
+        template<typename List>
+        concept KeywordList = TypeList<List> && meta::detail::all_keywords<List>::value;
+    }
+
+    enum class keyword_prefilter
+    {
+        none,
+        first_byte      // reject texts whose first byte starts no keyword before walking the trie
+    };
+
+    namespace detail {
+
+        template<concepts::KeywordList Keywords>
+        struct keyword_views;
+
+        template<template<typename...> typename XList, typename... Ks>
+        struct keyword_views<XList<Ks...>>
+        {
+            static constexpr std::array<std::string_view, sizeof...(Ks)> value = { Ks::value... };
+        };
+
+        // the number of trie nodes below the dead state and the number of byte classes, class 0 for bytes in no keyword
+        struct keyword_trie_shape
+        {
+            size_t nodes   = 0;
+            size_t classes = 0;
+        };
+
+        // A node per distinct prefix: in sorted order every keyword shares the nodes of its longest common prefix with
+        // the one before and adds a node per character past it. The merge passes of the sort (see
+        // common::detail::sorted_array) are constant evaluations of their own.
+        template<const auto& Words>
+        constexpr keyword_trie_shape make_keyword_trie_shape()
+        {
+            std::array<bool, 256> used{};
+            size_t nodes = 1;
+            std::string_view previous;
+            for(const std::string_view word : common::detail::sorted_array<Words, std::less<>>) {
+                size_t shared = 0;
+                while(shared < word.size() && shared < previous.size() && word[shared] == previous[shared]) {
+                    ++shared;
+                }
+                nodes += word.size() - shared;
+                for(const char c : word) {
+                    used[static_cast<unsigned char>(c)] = true;
+                }
+                previous = word;
+            }
+            return { nodes, 1 + static_cast<size_t>(std::count(used.begin(), used.end(), true)) };
+        }
+
+        //
+        // keyword_trie
+        // The trie as a transition table: state 0 is dead and loops onto itself, state 1 the root. Every byte maps to
+        // a class, the bytes of no keyword to class 0, which leads to the dead state from everywhere. accept holds the
+        // position of the first keyword ending in a state, the number of keywords for all others.
+        //
+        template<typename State, typename Class, typename Position, size_t States, size_t Classes>
+        struct keyword_trie
+        {
+            std::array<Class, 256>                  byte_class{};
+            std::array<State, States * Classes>     next{};
+            std::array<Position, States>            accept{};
+            std::array<std::uint64_t, 4>            first_bytes{};
+            size_t                                  max_length = 0;
+        };
+
+        template<typename State, typename Class, typename Position, size_t States, size_t Classes, size_t Size>
+        constexpr keyword_trie<State, Class, Position, States, Classes> make_keyword_trie(const std::array<std::string_view, Size>& words)
+        {
+            keyword_trie<State, Class, Position, States, Classes> trie{};
+            size_t classes = 1;
+            for(const std::string_view word : words) {
+                for(const char c : word) {
+                    const unsigned char byte = static_cast<unsigned char>(c);
+                    if(trie.byte_class[byte] == 0) {
+                        trie.byte_class[byte] = static_cast<Class>(classes++);
+                    }
+                }
+            }
+
+            trie.accept.fill(static_cast<Position>(Size));
+            size_t states = 2;
+            for(size_t position = 0; position < Size; ++position) {
+                const std::string_view word = words[position];
+                size_t state = 1;
+                for(const char c : word) {
+                    State& target = trie.next[state * Classes + trie.byte_class[static_cast<unsigned char>(c)]];
+                    if(target == 0) {
+                        target = static_cast<State>(states++);
+                    }
+                    state = target;
+                }
+                if(trie.accept[state] == Size) {
+                    trie.accept[state] = static_cast<Position>(position);
+                }
+                if(!word.empty()) {
+                    const unsigned char first = static_cast<unsigned char>(word.front());
+                    trie.first_bytes[first / 64] |= std::uint64_t(1) << (first % 64);
+                }
+                trie.max_length = std::max(trie.max_length, word.size());
+            }
+            return trie;
+        }
+
+        template<concepts::KeywordList Keywords>
+        struct keyword_matcher
+        {
+            using views = keyword_views<Keywords>;
+
+            static constexpr size_t size = type_list::size<Keywords>;
+            static constexpr size_t miss = size;
+
+            static constexpr keyword_trie_shape shape = make_keyword_trie_shape<views::value>();
+
+            static constexpr size_t states  = shape.nodes + 1;
+            static constexpr size_t classes = shape.classes;
+
+            using state    = smallest_unsigned_t<states - 1>;
+            using class_t  = smallest_unsigned_t<classes - 1>;
+            using position = smallest_unsigned_t<size>;
+
+            static constexpr keyword_trie<state, class_t, position, states, classes> trie =
+                make_keyword_trie<state, class_t, position, states, classes>(views::value);
+
+            // one table read per byte and no branch but the loop, bytes past a mismatch stay in the dead state
+            template<keyword_prefilter Prefilter>
+            static constexpr size_t find(std::string_view text)
+            {
+                if(text.size() > trie.max_length) {
+                    return miss;
+                }
+                if constexpr(Prefilter == keyword_prefilter::first_byte) {
+                    if(!text.empty()) {
+                        const unsigned char first = static_cast<unsigned char>(text.front());
+                        if(((trie.first_bytes[first / 64] >> (first % 64)) & 1) == 0) {
+                            return miss;
+                        }
+                    }
+                }
+                size_t current = 1;
+                for(const char c : text) {
+                    current = trie.next[current * classes + trie.byte_class[static_cast<unsigned char>(c)]];
+                }
+                return trie.accept[current];
+            }
+        };
+
+    }
+
+    //
+    // match_keyword< Keywords, Prefilter >( text )
+    // The position of text in a keyword list (see keywords), the size of the list if it is none of them, like
+    // value_list::lookup. The keywords are compiled into a trie once per list, matching reads one transition per byte
+    // of text and rejects texts longer than the longest keyword right away. keyword_prefilter::first_byte checks the
+    // first byte against a 256 bit set of the first bytes of the keywords before that, which pays off when most texts
+    // are not keywords, f.e.
+    //     match_keyword<keywords<"get", "set", "del">, keyword_prefilter::first_byte>(token)
+    //
+    template<concepts::KeywordList Keywords, keyword_prefilter Prefilter = keyword_prefilter::none>
+    constexpr size_t match_keyword(std::string_view text)
+    {
+        if constexpr(type_list::size<Keywords> == 0) {
+            return 0;
+        } else {
+            return detail::keyword_matcher<Keywords>::template find<Prefilter>(text);
+        }
+    }
+
+    //
+    // dispatch_keyword< Keywords, Prefilter >( text, f, miss )
+    // dispatch< Keywords > on the matched keyword, miss() for texts that are none, f.e.
+    //     dispatch_keyword<commands>(token, [&]<typename Command>() { run<Command>(arguments); }, [&] { unknown(token); });
+    //
+    template<concepts::KeywordList Keywords, keyword_prefilter Prefilter = keyword_prefilter::none, typename F, typename Miss>
+    constexpr typename detail::dispatch_result<Keywords, std::remove_reference_t<F>>::type dispatch_keyword(std::string_view text, F&& f, Miss&& miss)
+    {
+        static_assert(
+            std::is_same_v<std::invoke_result_t<Miss&>, typename detail::dispatch_result<Keywords, std::remove_reference_t<F>>::type>,
+            "dispatch_keyword: miss() must return the result type of f"
+        );
+
+        const size_t position = match_keyword<Keywords, Prefilter>(text);
+        if(position < type_list::size<Keywords>) {
+            return dispatch<Keywords>(position, f);
+        }
+        return miss();
+    }
+
+}
+
+#endif
@@ -0,0 +1,383 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef META_LOOKUP_HPP___
+#define META_LOOKUP_HPP___
+
+#include <meta/vlist.hpp>
+#include <meta/dispatch.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace meta {
+
+    namespace detail {
+
+        enum class lookup_strategy
+        {
+            dense,
+            perfect_hash,
+            binary_search
+        };
+
+        // the distinct keys of a list in ascending order with the position of their first occurrence
+        template<typename T, size_t Size>
+        struct sorted_keys
+        {
+            std::array<T, Size>      keys{};
+            std::array<size_t, Size> positions{};
+            size_t                   count = 0;
+        };
+
+        // a key and the position of its occurrence in the list
+        template<typename T>
+        struct lookup_entry
+        {
+            T      key{};
+            size_t position = 0;
+        };
+
+        struct lookup_entry_less
+        {
+            template<typename T>
+            constexpr bool operator()(const lookup_entry<T>& lhs, const lookup_entry<T>& rhs) const
+            {
+                return lhs.key < rhs.key;
+            }
+        };
+
+        template<const auto& Values>
+        inline constexpr auto lookup_entries = [] {
+            using value_type = typename std::remove_cvref_t<decltype(Values)>::value_type;
+
+            std::array<lookup_entry<value_type>, Values.size()> result{};
+            for(size_t i = 0; i < Values.size(); ++i) {
+                result[i] = { Values[i], i };
+            }
+            return result;
+        }();
+
+        // The entries of Values sorted by key with the merge passes of sort (see common::detail::sorted_array), each of
+        // which is a constant evaluation of its own. The merge is stable, so the first of equal keys is its first
+        // occurrence. The loops run on raw pointers, the constant evaluator counts every std::array::operator[] as a
+        // call.
+        template<const auto& Values>
+        constexpr auto make_sorted_keys()
+        {
+            using value_type = typename std::remove_cvref_t<decltype(Values)>::value_type;
+            constexpr size_t size = Values.size();
+
+            const lookup_entry<value_type>* const entries = common::detail::sorted_array<lookup_entries<Values>, lookup_entry_less>.data();
+
+            sorted_keys<value_type, size> result{};
+            value_type* const keys      = result.keys.data();
+            size_t* const     positions = result.positions.data();
+            size_t count = 0;
+            for(size_t i = 0; i < size; ++i) {
+                if(i == 0 || entries[i - 1].key < entries[i].key) {
+                    keys[count]      = entries[i].key;
+                    positions[count] = entries[i].position;
+                    ++count;
+                }
+            }
+            result.count = count;
+            return result;
+        }
+
+        // key - min, wrapping, so the distance between two keys of any integral type is its unsigned difference
+        template<typename T>
+        constexpr std::uint64_t key_offset(T key, T min)
+        {
+            return static_cast<std::uint64_t>(key) - static_cast<std::uint64_t>(min);
+        }
+
+        // the number of seeds tried before the keys are left to the binary search
+        static constexpr size_t lookup_max_seeds = 16;
+
+        // the most keys a perfect hash is built for, a seed takes about 1000 operations of the constant evaluator per key
+        static constexpr size_t lookup_max_hashed_keys = 8192;
+
+        constexpr std::uint64_t lookup_mix(std::uint64_t offset, std::uint64_t seed)
+        {
+            std::uint64_t x = (offset ^ seed) * 0x9E3779B97F4A7C15ull;
+            x ^= x >> 29;
+            x *= 0xBF58476D1CE4E5B9ull;
+            x ^= x >> 32;
+            return x;
+        }
+
+        //
+        // perfect_hash_layout
+        // Hash and displace: every key falls into one of Buckets buckets and a slot of Slots, which the displacement of
+        // its bucket shifts to a free one. The buckets are placed largest first, a seed is dropped as soon as a bucket
+        // does not fit anywhere.
+        //
+        template<typename T, size_t Slots, size_t Buckets, typename Position>
+        struct perfect_hash_layout
+        {
+            bool          found = false;
+            std::uint64_t seed  = 0;
+
+            std::array<smallest_unsigned_t<Slots - 1>, Buckets> displacement{};
+            std::array<T, Slots>                                 keys{};
+            std::array<Position, Slots>                          positions{};
+
+            constexpr size_t slot(std::uint64_t offset) const
+            {
+                const std::uint64_t x = lookup_mix(offset, seed);
+                return static_cast<size_t>(((x & (Slots - 1)) + displacement[(x >> 32) & (Buckets - 1)]) & (Slots - 1));
+            }
+        };
+
+        // The layout of seed number attempt, found is false if a bucket does not fit. The keys are grouped by bucket and
+        // the buckets by size with a counting sort each, so placing a bucket takes time in the number of its keys and the
+        // displacements tried. Raw pointers as in make_sorted_keys, positions without a key hold Size.
+        template<typename Position, size_t Slots, size_t Buckets, typename T, size_t Size>
+        constexpr perfect_hash_layout<T, Slots, Buckets, Position> make_perfect_hash(const sorted_keys<T, Size>& sorted, size_t attempt)
+        {
+            const size_t count = sorted.count;
+            const T* const keys = sorted.keys.data();
+
+            std::array<std::uint64_t, Size> offset_array{};
+            std::array<size_t, Size>        bucket_array{};
+            std::array<size_t, Size>        base_array{};
+            std::array<size_t, Size>        member_array{};
+            std::array<size_t, Buckets + 1> start_array{};
+            std::array<size_t, Buckets>     by_size_array{};
+            std::array<size_t, Size + 2>    size_start_array{};
+            std::array<bool, Slots>         taken_array{};
+            std::uint64_t* const offsets     = offset_array.data();
+            size_t* const        bucket_of   = bucket_array.data();
+            size_t* const        base        = base_array.data();
+            size_t* const        members     = member_array.data();
+            size_t* const        starts      = start_array.data();
+            size_t* const        by_size     = by_size_array.data();
+            size_t* const        size_starts = size_start_array.data();
+            bool* const          taken       = taken_array.data();
+
+            for(size_t i = 0; i < count; ++i) {
+                offsets[i] = key_offset(keys[i], keys[0]);
+            }
+
+            perfect_hash_layout<T, Slots, Buckets, Position> layout{};
+            layout.seed = lookup_mix(attempt, 0x2545F4914F6CDD1Dull);
+            for(size_t i = 0; i < count; ++i) {
+                const std::uint64_t x = lookup_mix(offsets[i], layout.seed);
+                bucket_of[i] = static_cast<size_t>((x >> 32) & (Buckets - 1));
+                base[i]      = static_cast<size_t>(x & (Slots - 1));
+                ++starts[bucket_of[i] + 1];
+            }
+
+            // buckets largest first: the number of buckets of every size, then their places in by_size
+            for(size_t b = 0; b < Buckets; ++b) {
+                ++size_starts[count - starts[b + 1] + 1];
+            }
+            for(size_t size = 0; size <= count; ++size) {
+                size_starts[size + 1] += size_starts[size];
+            }
+            for(size_t b = 0; b < Buckets; ++b) {
+                by_size[size_starts[count - starts[b + 1]]++] = b;
+            }
+
+            // the keys of bucket b at members[starts[b]] up to members[starts[b + 1]]
+            for(size_t b = 0; b < Buckets; ++b) {
+                starts[b + 1] += starts[b];
+            }
+            for(size_t i = 0; i < count; ++i) {
+                members[starts[bucket_of[i]]++] = i;
+            }
+            for(size_t b = Buckets; b != 0; --b) {
+                starts[b] = starts[b - 1];
+            }
+            starts[0] = 0;
+
+            bool placed = true;
+            for(size_t k = 0; placed && k < Buckets; ++k) {
+                const size_t b     = by_size[k];
+                const size_t begin = starts[b];
+                const size_t end   = starts[b + 1];
+                if(begin == end) {
+                    break;
+                }
+
+                // the keys of a bucket keep their distance, keys on the same base never fit
+                for(size_t i = begin; placed && i < end; ++i) {
+                    for(size_t j = begin; j < i; ++j) {
+                        placed = placed && (base[members[j]] != base[members[i]]);
+                    }
+                }
+
+                bool fits = false;
+                for(size_t d = 0; placed && !fits && d < Slots; ++d) {
+                    fits = true;
+                    for(size_t i = begin; fits && i < end; ++i) {
+                        fits = !taken[(base[members[i]] + d) & (Slots - 1)];
+                    }
+                    if(fits) {
+                        for(size_t i = begin; i < end; ++i) {
+                            taken[(base[members[i]] + d) & (Slots - 1)] = true;
+                        }
+                        layout.displacement[b] = static_cast<smallest_unsigned_t<Slots - 1>>(d);
+                    }
+                }
+                placed = placed && fits;
+            }
+
+            if(!placed) {
+                return perfect_hash_layout<T, Slots, Buckets, Position>{};
+            }
+
+            layout.found = true;
+            layout.positions.fill(static_cast<Position>(Size));
+            for(size_t i = 0; i < count; ++i) {
+                const size_t slot = layout.slot(offsets[i]);
+                layout.keys[slot]      = keys[i];
+                layout.positions[slot] = static_cast<Position>(sorted.positions[i]);
+            }
+            return layout;
+        }
+
+        // every seed is a constant evaluation of its own
+        template<const auto& Sorted, typename Position, size_t Slots, size_t Buckets, size_t Attempt>
+        inline constexpr auto perfect_hash_attempt = make_perfect_hash<Position, Slots, Buckets>(Sorted, Attempt);
+
+        // the layout of the first seed that hashes the keys perfectly, the last one tried if none does
+        template<const auto& Sorted, typename Position, size_t Slots, size_t Buckets, size_t Attempt = 0>
+        constexpr const auto& first_perfect_hash()
+        {
+            if constexpr(perfect_hash_attempt<Sorted, Position, Slots, Buckets, Attempt>.found || Attempt + 1 == lookup_max_seeds) {
+                return perfect_hash_attempt<Sorted, Position, Slots, Buckets, Attempt>;
+            } else {
+                return first_perfect_hash<Sorted, Position, Slots, Buckets, Attempt + 1>();
+            }
+        }
+
+        // the dense table: the position of every key in [min, max], miss in between
+        template<typename Position, size_t Range, typename T, size_t Size>
+        constexpr std::array<Position, Range> make_dense_table(const sorted_keys<T, Size>& sorted, size_t miss)
+        {
+            std::array<Position, Range> table{};
+            table.fill(static_cast<Position>(miss));
+            for(size_t i = 0; i < sorted.count; ++i) {
+                table[key_offset(sorted.keys[i], sorted.keys[0])] = static_cast<Position>(sorted.positions[i]);
+            }
+            return table;
+        }
+
+        //
+        // value_lookup< List >
+        // The search structure of value_list::lookup, chosen by the density of the keys: a table of positions over
+        // [min, max] for keys that fill at least a quarter of it, a perfect hash over twice as many slots as keys
+        // otherwise and a binary search over the sorted keys for up to 8 keys, more than lookup_max_hashed_keys keys or
+        // if no seed gives a perfect hash.
+        //
+        template<concepts::AnyValueList List>
+        struct value_lookup
+        {
+            using value_type = common::value_type_t<List>;
+            using position   = smallest_unsigned_t<value_list::size<List>>;
+
+            static constexpr size_t size = value_list::size<List>;
+            static constexpr size_t miss = size;
+
+            static constexpr sorted_keys<value_type, size> sorted = make_sorted_keys<value_list::to_array<List>>();
+
+            static constexpr std::uint64_t span = key_offset(sorted.keys[sorted.count - 1], sorted.keys[0]);
+
+            static constexpr size_t slots   = std::bit_ceil(2 * sorted.count);
+            static constexpr size_t buckets = std::bit_ceil(std::max<size_t>(sorted.count / 2, 1));
+
+            template<typename Self = value_lookup>
+            static constexpr const auto& perfect_hash = first_perfect_hash<Self::sorted, position, Self::slots, Self::buckets>();
+
+            // the perfect hash is only built for keys too sparse for the dense table and not too many to hash
+            static constexpr lookup_strategy choose()
+            {
+                if constexpr(span < 4 * sorted.count) {
+                    return lookup_strategy::dense;
+                } else if constexpr(sorted.count <= 8 || sorted.count > lookup_max_hashed_keys) {
+                    return lookup_strategy::binary_search;
+                } else {
+                    return perfect_hash<>.found ? lookup_strategy::perfect_hash : lookup_strategy::binary_search;
+                }
+            }
+
+            static constexpr lookup_strategy strategy = choose();
+
+            template<typename Self = value_lookup>
+            static constexpr auto dense = make_dense_table<position, static_cast<size_t>(Self::span) + 1>(Self::sorted, miss);
+
+            static constexpr size_t find(value_type key)
+            {
+                const std::uint64_t offset = key_offset(key, sorted.keys[0]);
+                if constexpr(strategy == lookup_strategy::dense) {
+                    return (offset <= span) ? dense<>[static_cast<size_t>(offset)] : miss;
+                } else if constexpr(strategy == lookup_strategy::perfect_hash) {
+                    const size_t slot = perfect_hash<>.slot(offset);
+                    return (perfect_hash<>.keys[slot] == key) ? perfect_hash<>.positions[slot] : miss;
+                } else {
+                    const auto found = std::lower_bound(sorted.keys.begin(), sorted.keys.begin() + sorted.count, key);
+                    return (found != sorted.keys.begin() + sorted.count && *found == key) ? sorted.positions[found - sorted.keys.begin()] : miss;
+                }
+            }
+        };
+
+    }
+
+    namespace value_list {
+
+        //
+        // lookup< List >( key )
+        // Runtime search of an integral value list: the position of the first occurrence of key, size<List> if there
+        // is none, like type_list::index_of. The search structure is built once per list at compile time and chosen by
+        // the density of the keys (see detail::value_lookup): the dense table and the perfect hash answer with a single
+        // probe, the binary search for short lists, very long ones and keys no seed hashes perfectly takes O(log n)
+        // steps. Sorting the keys and every seed of the perfect hash are constant evaluations of their own, so neither
+        // runs into -fconstexpr-ops-limit, f.e. for sparse message ids
+        //     value_list::lookup<vlist<std::uint16_t, 0x0101, 0x2a00, 0x8003>>(id)
+        //
+        template<concepts::AnyValueList List>
+        requires(std::integral<common::value_type_t<List>>)
+        constexpr size_t lookup(common::value_type_t<List> key)
+        {
+            if constexpr(size<List> == 0) {
+                return 0;
+            } else {
+                return detail::value_lookup<List>::find(key);
+            }
+        }
+
+    }
+
+    //
+    // dispatch_key< Keys, List >( key, f, miss )
+    // dispatch< List > on the position of key in Keys (see value_list::lookup), miss() for keys not in Keys, f.e.
+    //     dispatch_key<message_ids, message_types>(id, [&]<typename Message>() { handle<Message>(buffer); }, [] {});
+    //
+    template<concepts::AnyValueList Keys, concepts::TypeList List, typename F, typename Miss>
+    requires(value_list::size<Keys> == type_list::size<List>)
+    constexpr typename detail::dispatch_result<List, std::remove_reference_t<F>>::type dispatch_key(common::value_type_t<Keys> key, F&& f, Miss&& miss)
+    {
+        static_assert(
+            std::is_same_v<std::invoke_result_t<Miss&>, typename detail::dispatch_result<List, std::remove_reference_t<F>>::type>,
+            "dispatch_key: miss() must return the result type of f"
+        );
+
+        const size_t position = value_list::lookup<Keys>(key);
+        if(position < type_list::size<List>) {
+            return dispatch<List>(position, f);
+        }
+        return miss();
+    }
+
+}
+
+#endif
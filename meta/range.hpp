@@ -48,6 +48,18 @@ namespace meta {
     template<typename Begin, typename End>
     auto is_sentinel(iterator_range<Begin, End>) -> decltype(is_sentinel(std::declval<Begin>()));
 
+    // ranges of random access iterators are random access
+    template<concepts::RandomAccessIterator Begin, concepts::Iterator End>
+    struct iterator_position<iterator_range<Begin, End>> : iterator_position<Begin>
+    {};
+
+    template<concepts::RandomAccessIterator Begin, concepts::Iterator End, size_t N>
+    requires(N > 0)
+    struct advance_n<iterator_range<Begin, End>, N>
+    {
+        using type = iterator_range<advance_n_t<Begin, N>, End>;
+    };
+
     //
     // filter_range
     //
@@ -85,9 +85,14 @@ namespace meta
         requires(size<List> >= N)
         using split = common::split_t<List, N>;
 
-        // concat< List, List >
-        template<concepts::TypeList List1, concepts::TypeList List2>
-        using concat = common::concat_t<List1, List2>;
+        // concat< List, Lists... >
+        template<concepts::TypeList List, concepts::TypeList... Lists>
+        using concat = common::concat_t<List, Lists...>;
+
+        // flatten< List >
+        // leaves of a tree of nested type lists, in left to right order
+        template<concepts::TypeList List>
+        using flatten = common::flatten_t<List>;
 
         // insert< List, N, List >
         template<concepts::TypeList Dest, size_t N, concepts::TypeList Source>
@@ -114,6 +119,62 @@ namespace meta
 
         template<concepts::TypeList List, template<typename> typename Predicate>
         using copy_if = common::copy_if_tlist_t<List, Predicate>;
+
+        // sort< List, Compare >
+        // stable sort, Compare<A, B>::value is true if A goes before B
+        template<concepts::TypeList List, template<typename A, typename B> typename Compare>
+        using sort = common::sort_tlist_t<List, Compare>;
+
+        // unique< List >
+        // first occurrence of every element, in list order
+        template<concepts::TypeList List>
+        using unique = common::unique_tlist_t<List>;
+
+        // set_union< Lhs, Rhs >
+        // unique< Lhs > followed by the elements of Rhs that are not in Lhs
+        template<concepts::TypeList Lhs, concepts::TypeList Rhs>
+        using set_union = common::set_union_tlist_t<Lhs, Rhs>;
+
+        // set_intersection< Lhs, Rhs >
+        // elements of unique< Lhs > that are in Rhs
+        template<concepts::TypeList Lhs, concepts::TypeList Rhs>
+        using set_intersection = common::set_intersection_tlist_t<Lhs, Rhs>;
+
+        // set_difference< Lhs, Rhs >
+        // elements of unique< Lhs > that are not in Rhs
+        template<concepts::TypeList Lhs, concepts::TypeList Rhs>
+        using set_difference = common::set_difference_tlist_t<Lhs, Rhs>;
+
+        // is_subset< Lhs, Rhs >
+        // every element of Lhs is in Rhs, a concept like contains
+        template<typename Lhs, typename Rhs>
+        concept is_subset = concepts::TypeList<Lhs> && concepts::TypeList<Rhs> && common::is_subset_tlist<Lhs, Rhs>::value;
+
+        // contains< List, T >
+        // a concept, so it can constrain templates directly and a query never instantiates a variable named after
+        // the whole list
+        template<typename List, typename T>
+        concept contains = concepts::TypeList<List> && common::contains_tlist<List, T>::value;
+
+        // index_of< List, T >
+        // index of the first occurrence of T, size<List> if there is none
+        template<concepts::TypeList List, typename T>
+        constexpr size_t index_of = common::index_of_tlist<List, T>::value;
+
+        // find_if< List, Predicate >
+        // index of the first element satisfying Predicate, size<List> if there is none
+        template<concepts::TypeList List, template<typename> typename Predicate>
+        constexpr size_t find_if = common::find_if_tlist<List, Predicate>::value;
+
+        // to_array< List, Projection, T >
+        // Projection<E>::value of every element as a constexpr std::array<T, size>, f.e. the ids of the leaves
+        // accumulated from a tree traversal. T defaults to the type of the first projected value, empty lists need it
+        // spelled out. Identical sequences of values share one object, see common::to_array_tlist.
+        template<
+            concepts::TypeList List, template<typename> typename Projection,
+            typename T = typename common::detail::projection_type<List, Projection>::type
+        >
+        constexpr const auto& to_array = common::to_array_tlist<List, Projection, T>::value;
     }
 
     template<concepts::TypeList List, size_t Pos>
@@ -160,25 +221,14 @@ namespace meta
     template<concepts::TypeList List>
     auto is_sentinel(tlist_iterator<List, type_list::size<List>>) -> std::true_type;
 
-    namespace detail {
-
-        template<typename Tlist>
-        struct tlist_front_back_base
-        {
-            using front = type_list::front<Tlist>;
-            using back  = type_list::back<Tlist>;
-        };
-
-        template<template<typename...> typename Tlist>
-        struct tlist_front_back_base< Tlist<> >
-        {
-
-        };
-
-    }
-
+    //
+    // tlist
+    // Members that compute something are templates defaulted to the list itself (f.e. tlist<int, float>::back<>), so
+    // they are only evaluated when they are named. Naming or instantiating a tlist, like the tree traversals do for
+    // every path stack, stays cheap.
+    //
     template <typename... Elems>
-    struct tlist : public detail::tlist_front_back_base<tlist<Elems...>>
+    struct tlist
     {
         static constexpr size_t size = type_list::size<tlist>;
 
@@ -189,16 +239,32 @@ namespace meta
 
         using cleared = type_list::clear<tlist>;
 
+        template<concepts::TypeList Self = tlist>
+        using front = type_list::front<Self>;
+
+        template<concepts::TypeList Self = tlist>
+        using back = type_list::back<Self>;
+
+        template<concepts::TypeList Self = tlist>
+        using pop_front = type_list::pop_front<Self>;
+
+        template<concepts::TypeList Self = tlist>
+        using pop_back = type_list::pop_back<Self>;
+
         template<typename T>
         using push_front = type_list::push_front<tlist, T>;
 
         template<typename T>
         using push_back  = type_list::push_back<tlist, T>;
 
-        using reverse = type_list::reverse<tlist>;
+        template<concepts::TypeList Self = tlist>
+        using reverse = type_list::reverse<Self>;
 
-        template<concepts::TypeList Other>
-        using concat = type_list::concat<tlist, Other>;
+        template<concepts::TypeList... Others>
+        using concat = type_list::concat<tlist, Others...>;
+
+        template<concepts::TypeList Self = tlist>
+        using flatten = type_list::flatten<Self>;
 
         template<template <typename T> typename Transformer>
         using transform = type_list::transform<tlist, Transformer>;
@@ -209,6 +275,36 @@ namespace meta
         template<template<typename> typename Predicate>
         using copy_if = type_list::copy_if<tlist, Predicate>;
 
+        template<template<typename A, typename B> typename Compare>
+        using sort = type_list::sort<tlist, Compare>;
+
+        template<concepts::TypeList Self = tlist>
+        using unique = type_list::unique<Self>;
+
+        template<concepts::TypeList Other>
+        using set_union = type_list::set_union<tlist, Other>;
+
+        template<concepts::TypeList Other>
+        using set_intersection = type_list::set_intersection<tlist, Other>;
+
+        template<concepts::TypeList Other>
+        using set_difference = type_list::set_difference<tlist, Other>;
+
+        template<concepts::TypeList Other>
+        static constexpr bool is_subset = type_list::is_subset<tlist, Other>;
+
+        template<typename T>
+        static constexpr bool contains = type_list::contains<tlist, T>;
+
+        template<typename T>
+        static constexpr size_t index_of = type_list::index_of<tlist, T>;
+
+        template<template<typename> typename Predicate>
+        static constexpr size_t find_if = type_list::find_if<tlist, Predicate>;
+
+        template<template<typename> typename Projection>
+        static constexpr const auto& to_array = type_list::to_array<tlist, Projection>;
+
         template<template< typename... > typename OtherListType>
         using as = OtherListType<Elems...>;
 
@@ -2,10 +2,15 @@
 #define META_TREE_HPP__
 
 #include <meta/tlist.hpp>
+#include <meta/vlist.hpp>
 #include <meta/iterator.hpp>
 #include <meta/range.hpp>
+#include <meta/algorithm.hpp>
+#include <algorithm>
+#include <array>
 #include <system_error>
 #include <type_traits>
+#include <utility>
 
 namespace meta {
 
@@ -82,6 +87,22 @@ namespace meta {
 
         };
 
+        //
+        // indexed
+        //
+        // The trees of another context, with iterators that keep their position as the root plus the child indices on the way
+        // down (see detail::index_path) instead of one stack element per ancestor. Every ancestor is a full node type, so the
+        // names of the default iterators grow with depth x tree size; indexed ones name the root once, which takes the
+        // object file of benchmark/tree_instantiation.cpp from 26.9MB to 15.6MB at depth 4. Nodes are looked up from the
+        // root again when they are needed.
+        //
+        // f.e. range_lr<Root, contexts::indexed<contexts::tlist>>
+        //
+        template<typename Ctx>
+        struct indexed : Ctx
+        {
+        };
+
     }
 
     namespace concepts {
@@ -104,6 +125,165 @@ namespace meta {
     template<typename Ctx, concepts::InnerNode<Ctx> Node, size_t Index>
     using node_get_child_t = typename Ctx::template get_child<Node, Index>::type;
 
+    namespace detail {
+
+        template<typename Ctx, typename Node, typename Indices = std::make_index_sequence<node_num_children_v<Ctx, Node>>>
+        struct node_children;
+
+        template<typename Ctx, typename Node, size_t... Is>
+        struct node_children<Ctx, Node, std::index_sequence<Is...>>
+        {
+            using type = meta::tlist<node_get_child_t<Ctx, Node, Is>...>;
+        };
+
+        // the size (nodes including the node itself), number of leaves and height of the subtree below a node
+        template<typename Ctx, typename Node, typename Indices = std::make_index_sequence<node_num_children_v<Ctx, Node>>>
+        struct node_subtree;
+
+        template<typename Ctx, typename Node, size_t... Is>
+        struct node_subtree<Ctx, Node, std::index_sequence<Is...>>
+        {
+            static constexpr size_t size   = (1 + ... + node_subtree<Ctx, node_get_child_t<Ctx, Node, Is>>::size);
+            static constexpr size_t leaves = (0 + ... + node_subtree<Ctx, node_get_child_t<Ctx, Node, Is>>::leaves);
+            static constexpr size_t height = 1 + std::max({ node_subtree<Ctx, node_get_child_t<Ctx, Node, Is>>::height... });
+        };
+
+        template<typename Ctx, typename Node>
+        struct node_subtree<Ctx, Node, std::index_sequence<>>
+        {
+            static constexpr size_t size   = 1;
+            static constexpr size_t leaves = 1;
+            static constexpr size_t height = 0;
+        };
+
+    }
+
+    // The children of a node as a tlist
+    template<typename Ctx, concepts::TreeNode<Ctx> Node>
+    using node_children_t = typename detail::node_children<Ctx, Node>::type;
+
+    // Number of nodes in the subtree of a node, the node included
+    template<typename Ctx, concepts::TreeNode<Ctx> Node>
+    static constexpr size_t node_subtree_size_v = detail::node_subtree<Ctx, Node>::size;
+
+    // Number of leaves in the subtree of a node
+    template<typename Ctx, concepts::TreeNode<Ctx> Node>
+    static constexpr size_t node_leaf_count_v = detail::node_subtree<Ctx, Node>::leaves;
+
+    // Number of edges on the longest path from a node down to a leaf
+    template<typename Ctx, concepts::TreeNode<Ctx> Node>
+    static constexpr size_t node_height_v = detail::node_subtree<Ctx, Node>::height;
+
+    namespace detail {
+
+        // the leaf index of the first leaf below every child of a node relative to the node's first leaf, followed by
+        // the number of leaves below the node
+        template<typename Ctx, typename Node, typename Indices = std::make_index_sequence<node_num_children_v<Ctx, Node>>>
+        struct child_leaf_offsets;
+
+        template<typename Ctx, typename Node, size_t... Is>
+        struct child_leaf_offsets<Ctx, Node, std::index_sequence<Is...>>
+        {
+            static constexpr std::array<size_t, sizeof...(Is) + 1> value = [] {
+                const std::array<size_t, sizeof...(Is)> counts = { node_subtree<Ctx, node_get_child_t<Ctx, Node, Is>>::leaves... };
+                std::array<size_t, sizeof...(Is) + 1> result{};
+                for(size_t i = 0; i < counts.size(); ++i) {
+                    result[i + 1] = result[i] + counts[i];
+                }
+                return result;
+            }();
+        };
+
+        template<typename Ctx, typename Node, size_t... Is>
+        struct leaf_index_at
+        {
+            static constexpr size_t value = 0;
+        };
+
+        template<typename Ctx, typename Node, size_t I, size_t... Is>
+        struct leaf_index_at<Ctx, Node, I, Is...>
+        {
+            static constexpr size_t value =
+                child_leaf_offsets<Ctx, Node>::value[I] + leaf_index_at<Ctx, node_get_child_t<Ctx, Node, I>, Is...>::value;
+        };
+
+        template<typename Ctx, typename Root, concepts::ValueList IndexPath>
+        struct leaf_index_at_indices;
+
+        template<typename Ctx, typename Root, size_t... Is>
+        struct leaf_index_at_indices<Ctx, Root, vlist<size_t, Is...>> : leaf_index_at<Ctx, Root, Is...>
+        {
+        };
+
+        // descend into the child whose leaves contain leaf N, N relative to the first leaf below Node
+        template<typename Ctx, typename Node, size_t N, typename Path, bool Leaf = concepts::LeafNode<Node, Ctx>>
+        struct leaf_path_at
+        {
+            using type = Path;
+        };
+
+        template<typename Ctx, typename Node, size_t N, typename Path>
+        struct leaf_path_at<Ctx, Node, N, Path, false>
+        {
+            static constexpr const auto& offsets = child_leaf_offsets<Ctx, Node>::value;
+            static constexpr size_t      index   = std::upper_bound(offsets.begin(), offsets.end(), N) - offsets.begin() - 1;
+
+            using type = typename leaf_path_at<Ctx, node_get_child_t<Ctx, Node, index>, N - offsets[index], value_list::push_back<Path, index>>::type;
+        };
+
+        template<typename Ctx, typename Node, typename Indices = std::make_index_sequence<node_num_children_v<Ctx, Node>>>
+        struct node_leaves;
+
+        template<typename Ctx, typename Node, size_t... Is>
+        struct node_leaves<Ctx, Node, std::index_sequence<Is...>>
+        {
+            using type = type_list::concat<meta::tlist<>, typename node_leaves<Ctx, node_get_child_t<Ctx, Node, Is>>::type...>;
+        };
+
+        template<typename Ctx, typename Node>
+        struct node_leaves<Ctx, Node, std::index_sequence<>>
+        {
+            using type = meta::tlist<Node>;
+        };
+
+    }
+
+    //
+    // leaf_index_of< Root, Ctx, IndexPath >, leaf_path_of< Root, Ctx, N >
+    // Convert between the two addresses of a leaf: its index in a left to right leaf traversal and its index path, the
+    // vlist<size_t, ...> of the child taken at every level starting at the root (see detail::index_path). Both take one
+    // step per level, at each of which they look up the leaf counts of the children (node_leaf_count_v) summed up.
+    // leaf_index_of a path to an inner node is the index of its first leaf.
+    //
+    template<typename Root, typename Ctx, concepts::ValueList IndexPath>
+    struct leaf_index_of : detail::leaf_index_at_indices<Ctx, Root, IndexPath>
+    {};
+
+    template<typename Root, typename Ctx, concepts::ValueList IndexPath>
+    static constexpr size_t leaf_index_of_v = leaf_index_of<Root, Ctx, IndexPath>::value;
+
+    template<typename Root, typename Ctx, size_t N>
+    requires(N < node_leaf_count_v<Ctx, Root>)
+    struct leaf_path_of : detail::leaf_path_at<Ctx, Root, N, vlist<size_t>>
+    {};
+
+    template<typename Root, typename Ctx, size_t N>
+    using leaf_path_of_t = typename leaf_path_of<Root, Ctx, N>::type;
+
+    //
+    // leaf_index_of_type< Root, Ctx, Leaf >
+    // The leaf index of the first leaf of type Leaf, the number of leaves if there is none. The leaf list is collected
+    // once per tree and searched like type_list::index_of, so every lookup is a single overload resolution.
+    //
+    template<typename Root, typename Ctx, typename Leaf>
+    struct leaf_index_of_type
+    {
+        static constexpr size_t value = type_list::index_of<typename detail::node_leaves<Ctx, Root>::type, Leaf>;
+    };
+
+    template<typename Root, typename Ctx, typename Leaf>
+    static constexpr size_t leaf_index_of_type_v = leaf_index_of_type<Root, Ctx, Leaf>::value;
+
     namespace detail {
 
         // StackElement (abbreviated SE to keep the type names short)
@@ -114,12 +294,195 @@ namespace meta {
             static constexpr size_t pos = Pos;
         };
 
+        template<typename T>
+        struct strip_se
+        {
+            using type = T;
+        };
+
+        template<typename Node, size_t Pos>
+        struct strip_se<SE<Node, Pos>>
+        {
+            using type = Node;
+        };
+
+        // index_path< Root, Is... >
+        // Compact path stack of contexts::indexed: the root and the index of the child taken at every level, starting at
+        // the root. The current node is Root[I0][I1]...
+        template<typename Root, size_t... Is>
+        struct index_path
+        {
+            using root    = Root;
+            using indices = vlist<size_t, Is...>;
+        };
+
+        template<typename Ctx, typename Node, size_t... Is>
+        struct node_at
+        {
+            using type = Node;
+        };
+
+        template<typename Ctx, typename Node, size_t I, size_t... Is>
+        struct node_at<Ctx, Node, I, Is...>
+        {
+            using type = typename node_at<Ctx, node_get_child_t<Ctx, Node, I>, Is...>::type;
+        };
+
+        template<typename Ctx, typename Root, concepts::ValueList Indices>
+        struct node_at_indices;
+
+        template<typename Ctx, typename Root, size_t... Is>
+        struct node_at_indices<Ctx, Root, vlist<size_t, Is...>> : node_at<Ctx, Root, Is...>
+        {
+        };
+
+        template<typename Root, concepts::ValueList Indices>
+        struct make_index_path;
+
+        template<typename Root, size_t... Is>
+        struct make_index_path<Root, vlist<size_t, Is...>>
+        {
+            using type = index_path<Root, Is...>;
+        };
+
+        //
+        // Path stack primitives
+        // The traversal algorithms below only touch a path stack through these, so they run on either encoding.
+        //
+
+        // stack_size: number of nodes on the path, 0 for anything that is not a path stack
+        template<typename Stack>
+        struct stack_size
+        {
+            static constexpr size_t value = 0;
+        };
+
+        template<meta::concepts::TypeList Stack>
+        struct stack_size<Stack>
+        {
+            static constexpr size_t value = type_list::size<Stack>;
+        };
+
+        template<typename Root, size_t... Is>
+        struct stack_size<index_path<Root, Is...>>
+        {
+            static constexpr size_t value = sizeof...(Is) + 1;
+        };
+
+        template<typename Stack>
+        static constexpr size_t stack_size_v = stack_size<Stack>::value;
+
+        // stack_top: the current node
+        template<typename Ctx, typename Stack>
+        struct stack_top
+        {
+            using type = type_list::front<Stack>;
+        };
+
+        template<typename Ctx, typename Root, size_t... Is>
+        struct stack_top<Ctx, index_path<Root, Is...>> : node_at<Ctx, Root, Is...>
+        {
+        };
+
+        template<typename Ctx, typename Stack>
+        using stack_top_t = typename stack_top<Ctx, Stack>::type;
+
+        // stack_parent: the parent of the current node (node) and the index of the current node in it (pos)
+        template<typename Ctx, typename Stack>
+        struct stack_parent : type_list::get<Stack, 1>
+        {
+        };
+
+        template<typename Ctx, typename Root, size_t... Is>
+        struct stack_parent<Ctx, index_path<Root, Is...>>
+        {
+            using node = typename node_at_indices<Ctx, Root, value_list::pop_back<vlist<size_t, Is...>>>::type;
+            static constexpr size_t pos = value_list::back<vlist<size_t, Is...>>;
+        };
+
+        // stack_root: the root of the tree
+        template<typename Stack>
+        struct stack_root : strip_se<type_list::back<Stack>>
+        {
+        };
+
+        template<typename Root, size_t... Is>
+        struct stack_root<index_path<Root, Is...>>
+        {
+            using type = Root;
+        };
+
+        template<typename Stack>
+        using stack_root_t = typename stack_root<Stack>::type;
+
+        // stack_path: the nodes from the root down to the current node, as a tlist
+        template<typename Ctx, typename Stack>
+        struct stack_path
+        {
+            using type = type_list::reverse<type_list::transform<Stack, strip_se>>;
+        };
+
+        template<typename Ctx, typename Path, typename Node, size_t... Is>
+        struct index_path_nodes
+        {
+            using type = type_list::push_back<Path, Node>;
+        };
+
+        template<typename Ctx, typename Path, typename Node, size_t I, size_t... Is>
+        struct index_path_nodes<Ctx, Path, Node, I, Is...>
+        {
+            using type = typename index_path_nodes<Ctx, type_list::push_back<Path, Node>, node_get_child_t<Ctx, Node, I>, Is...>::type;
+        };
+
+        template<typename Ctx, typename Root, size_t... Is>
+        struct stack_path<Ctx, index_path<Root, Is...>> : index_path_nodes<Ctx, meta::tlist<>, Root, Is...>
+        {
+        };
+
+        template<typename Ctx, typename Stack>
+        using stack_path_t = typename stack_path<Ctx, Stack>::type;
+
+        // stack_indices: the index of the child taken at every level from the root down, as a vlist<size_t, ...>
+        template<typename Stack>
+        struct stack_indices;
+
+        template<typename Top, typename... Elements>
+        struct stack_indices<meta::tlist<Top, Elements...>>
+        {
+            using type = value_list::reverse<vlist<size_t, Elements::pos...>>;
+        };
+
+        template<typename Root, size_t... Is>
+        struct stack_indices<index_path<Root, Is...>>
+        {
+            using type = vlist<size_t, Is...>;
+        };
+
+        template<typename Stack>
+        using stack_indices_t = typename stack_indices<Stack>::type;
+
+        // root_stack: the path stack of a root, index_path for contexts::indexed
+        template<typename Ctx, typename Root>
+        struct root_stack
+        {
+            using type = meta::tlist<Root>;
+        };
+
+        template<typename Ctx, typename Root>
+        struct root_stack<contexts::indexed<Ctx>, Root>
+        {
+            using type = index_path<Root>;
+        };
+
+        template<typename Ctx, typename Root>
+        using root_stack_t = typename root_stack<Ctx, Root>::type;
+
         template<typename Stack, typename Ctx>
         concept PathStack =
-            meta::concepts::TypeList<Stack> &&
-            (type_list::size<Stack> > 0) &&
-            (concepts::TreeNode<type_list::front<Stack>, Ctx>);
+            (stack_size_v<Stack> > 0) &&
+            (concepts::TreeNode<stack_top_t<Ctx, Stack>, Ctx>);
 
+        // The default path stack:
         // All traversal algorithms work on a tree path represented as a TypeList representing a "stack", where the front element is
         // the top of the stack.
         // The top of the stack is a plain tree node represending the "Current" node.
@@ -140,69 +503,75 @@ namespace meta {
         //
 
         template<typename Ctx, PathStack<Ctx> Stack>
-        requires(type_list::size<Stack> > 1)
-        using parent_node_t = typename meta::type_list::get<Stack, 1>::node;
+        requires(stack_size_v<Stack> > 1)
+        using parent_node_t = typename stack_parent<Ctx, Stack>::node;
 
         template<typename Ctx, PathStack<Ctx> Stack>
-        requires(type_list::size<Stack> > 1)
-        static constexpr size_t top_node_pos_v = meta::type_list::get<Stack, 1>::pos;
+        requires(stack_size_v<Stack> > 1)
+        static constexpr size_t top_node_pos_v = stack_parent<Ctx, Stack>::pos;
 
         template<typename Ctx, PathStack<Ctx> Stack>
-        requires(type_list::size<Stack> > 1)
+        requires(stack_size_v<Stack> > 1)
         static constexpr size_t parent_num_children_v = node_num_children_v<Ctx, parent_node_t<Ctx, Stack>>;
 
         //
         // has_left_sibling(_v)
         // check if the node addressed by the path stack has a right sibling
         //
-        template<typename Ctx, concepts::TypeList Stack>
+        template<typename Ctx, typename Stack>
         struct has_left_sibling
         {
             static constexpr bool value = false;
         };
 
-        template<typename Ctx, concepts::TypeList Stack>
-        requires(type_list::size<Stack> > 1)
+        template<typename Ctx, typename Stack>
+        requires(stack_size_v<Stack> > 1)
         struct has_left_sibling<Ctx, Stack>
         {
             static constexpr bool value = top_node_pos_v<Ctx, Stack> > 0;
         };
 
-        template<typename Ctx, concepts::TypeList Stack>
+        template<typename Ctx, typename Stack>
         static constexpr bool has_left_sibling_v = has_left_sibling<Ctx, Stack>::value;
 
         //
         // has_right_sibling(_v)
         // check if the node addressed by the path stack has a right sibling
         //
-        template<typename Ctx, concepts::TypeList Stack>
+        template<typename Ctx, typename Stack>
         struct has_right_sibling
         {
             static constexpr bool value = false;
         };
 
-        template<typename Ctx, concepts::TypeList Stack>
-        requires(type_list::size<Stack> > 1)
+        template<typename Ctx, typename Stack>
+        requires(stack_size_v<Stack> > 1)
         struct has_right_sibling<Ctx, Stack>
         {
             static constexpr bool value = (top_node_pos_v<Ctx, Stack> + 1) < parent_num_children_v<Ctx, Stack>;
         };
 
-        template<typename Ctx, concepts::TypeList Stack>
+        template<typename Ctx, typename Stack>
         static constexpr bool has_right_sibling_v = has_right_sibling<Ctx, Stack>::value;
 
         //
         // ascend_one(_t)
         //
 
-        template<typename Ctx, PathStack<Ctx> Stack, typename ParentElement = type_list::get<Stack, 1>>
-        requires(type_list::size<Stack> > 1)
+        template<typename Ctx, PathStack<Ctx> Stack>
+        requires(stack_size_v<Stack> > 1)
         struct ascend_one
         {
             // Remove the node and the StackElement containing the parent
             using type = type_list::set<type_list::pop_front<Stack>, 0, parent_node_t<Ctx, Stack>>;
         };
 
+        template<typename Ctx, typename Root, size_t... Is>
+        struct ascend_one<Ctx, index_path<Root, Is...>>
+        {
+            using type = typename make_index_path<Root, value_list::pop_back<vlist<size_t, Is...>>>::type;
+        };
+
         template<typename Ctx, PathStack<Ctx> Stack>
         using ascend_one_t = typename ascend_one<Ctx, Stack>::type;
 
@@ -210,20 +579,26 @@ namespace meta {
         // descend_one(_t)
         //
 
-        template<typename Ctx, concepts::TypeList Stack, size_t Pos, concepts::InnerNode<Ctx> Top = type_list::front<Stack>>
+        template<typename Ctx, PathStack<Ctx> Stack, size_t Pos, concepts::InnerNode<Ctx> Top = stack_top_t<Ctx, Stack>>
         requires(Pos < node_num_children_v<Ctx, Top>)
         struct descend_one
         {
             using type = type_list::push_front<type_list::set<Stack, 0, SE<Top, Pos>>, node_get_child_t<Ctx, Top, Pos>>;
         };
 
+        template<typename Ctx, typename Root, size_t... Is, size_t Pos, concepts::InnerNode<Ctx> Top>
+        struct descend_one<Ctx, index_path<Root, Is...>, Pos, Top>
+        {
+            using type = index_path<Root, Is..., Pos>;
+        };
+
         template<typename Ctx, PathStack<Ctx> Stack, size_t Pos>
         using descend_one_t = typename descend_one<Ctx, Stack, Pos>::type;
 
         //
         // descend_deep_left: beginning at some node N, take the left-most child until reaching a leaf.
         //
-        template<typename Ctx, PathStack<Ctx> Stack, concepts::TreeNode<Ctx> Top = meta::type_list::front<Stack>>
+        template<typename Ctx, PathStack<Ctx> Stack, concepts::TreeNode<Ctx> Top = stack_top_t<Ctx, Stack>>
         struct descend_deep_left
         {
             using type = typename descend_deep_left<Ctx, descend_one_t<Ctx, Stack, 0>>::type;
@@ -249,7 +624,7 @@ namespace meta {
         //
         // descend_deep_right: beginning at some node N, take the right-most child until reaching a leaf.
         //
-        template<typename Ctx, PathStack<Ctx> Stack, concepts::TreeNode<Ctx> Top = type_list::front<Stack>>
+        template<typename Ctx, PathStack<Ctx> Stack, concepts::TreeNode<Ctx> Top = stack_top_t<Ctx, Stack>>
         struct descend_deep_right
         {
             using type = typename descend_deep_right<Ctx, descend_one_t<Ctx, Stack, node_num_children_v<Ctx, Top> - 1>>::type;
@@ -277,7 +652,7 @@ namespace meta {
         //
 
         // PS: Inner node, no right sibling
-        template<typename Ctx, PathStack<Ctx> Stack, size_t Size = type_list::size<Stack>>
+        template<typename Ctx, PathStack<Ctx> Stack, size_t Size = stack_size_v<Stack>>
         struct ascend_next_right_sibling
         {
             using type = typename ascend_next_right_sibling<Ctx, ascend_one_t<Ctx, Stack>>::type;
@@ -301,6 +676,157 @@ namespace meta {
         template<typename Ctx, PathStack<Ctx> Stack>
         using ascend_next_right_sibling_t = typename ascend_next_right_sibling<Ctx, Stack>::type;
 
+        //
+        // ascend node stack upwards until we find a left sibling and then switch to that left sibling
+        //
+
+        // PS: Inner node, no left sibling
+        template<typename Ctx, PathStack<Ctx> Stack, size_t Size = stack_size_v<Stack>>
+        struct ascend_next_left_sibling
+        {
+            using type = typename ascend_next_left_sibling<Ctx, ascend_one_t<Ctx, Stack>>::type;
+        };
+
+        // PS: Inner node, left sibling
+        template<typename Ctx, PathStack<Ctx> Stack, size_t Size>
+        requires(has_left_sibling_v<Ctx, Stack>)
+        struct ascend_next_left_sibling<Ctx, Stack, Size>
+        {
+            using type = descend_one_t<Ctx, ascend_one_t<Ctx, Stack>, top_node_pos_v<Ctx, Stack> - 1>;
+        };
+
+        // PS: root
+        template<typename Ctx, PathStack<Ctx> Stack>
+        struct ascend_next_left_sibling<Ctx, Stack, 1>
+        {
+            using type = sentinel<>;
+        };
+
+        template<typename Ctx, PathStack<Ctx> Stack>
+        using ascend_next_left_sibling_t = typename ascend_next_left_sibling<Ctx, Stack>::type;
+
+        //
+        // first_at_depth / last_at_depth: the left-most / right-most node Depth levels below the top of the stack,
+        // sentinel<> if the subtree is not that deep. Child is the number of children already searched.
+        //
+        template<typename Ctx, PathStack<Ctx> Stack, size_t Depth, bool LeftToRight, size_t Child = 0, size_t NumChildren = node_num_children_v<Ctx, stack_top_t<Ctx, Stack>>>
+        struct node_at_depth;
+
+        template<typename Found, typename Ctx, typename Stack, size_t Depth, bool LeftToRight, size_t Child>
+        struct node_at_depth_or_next
+        {
+            using type = Found;
+        };
+
+        template<typename Ctx, typename Stack, size_t Depth, bool LeftToRight, size_t Child>
+        struct node_at_depth_or_next<sentinel<>, Ctx, Stack, Depth, LeftToRight, Child>
+        {
+            using type = typename node_at_depth<Ctx, Stack, Depth, LeftToRight, Child>::type;
+        };
+
+        template<typename Ctx, PathStack<Ctx> Stack, size_t Depth, bool LeftToRight, size_t Child, size_t NumChildren>
+        struct node_at_depth
+        {
+            using type = typename node_at_depth_or_next<
+                typename node_at_depth<Ctx, descend_one_t<Ctx, Stack, LeftToRight ? Child : NumChildren - 1 - Child>, Depth - 1, LeftToRight>::type,
+                Ctx, Stack, Depth, LeftToRight, Child + 1
+            >::type;
+        };
+
+        template<typename Ctx, PathStack<Ctx> Stack, size_t Depth, bool LeftToRight, size_t Child, size_t NumChildren>
+        requires(Depth == 0)
+        struct node_at_depth<Ctx, Stack, Depth, LeftToRight, Child, NumChildren>
+        {
+            using type = Stack;
+        };
+
+        template<typename Ctx, PathStack<Ctx> Stack, size_t Depth, bool LeftToRight, size_t Child, size_t NumChildren>
+        requires(Depth != 0 && Child == NumChildren)
+        struct node_at_depth<Ctx, Stack, Depth, LeftToRight, Child, NumChildren>
+        {
+            using type = sentinel<>;
+        };
+
+        template<typename Ctx, PathStack<Ctx> Stack, size_t Depth>
+        using first_at_depth_t = typename node_at_depth<Ctx, Stack, Depth, true>::type;
+
+        template<typename Ctx, PathStack<Ctx> Stack, size_t Depth>
+        using last_at_depth_t = typename node_at_depth<Ctx, Stack, Depth, false>::type;
+
+        //
+        // next_at_depth: the next node to the right (to the left for !LeftToRight) on the level of the top of the stack,
+        // sentinel<> if there is none. Up is the number of levels the search has ascended so far.
+        //
+
+        template<typename Ctx, typename Stack, bool LeftToRight>
+        static constexpr bool has_next_sibling_v = LeftToRight ? has_right_sibling_v<Ctx, Stack> : has_left_sibling_v<Ctx, Stack>;
+
+        // PS: no sibling in that direction
+        template<typename Ctx, PathStack<Ctx> Stack, bool LeftToRight, size_t Up = 0>
+        struct next_at_depth
+        {
+            using type = typename next_at_depth<Ctx, ascend_one_t<Ctx, Stack>, LeftToRight, Up + 1>::type;
+        };
+
+        template<typename Found, typename Ctx, typename Sibling, bool LeftToRight, size_t Up>
+        struct next_at_depth_or_next
+        {
+            using type = Found;
+        };
+
+        template<typename Ctx, typename Sibling, bool LeftToRight, size_t Up>
+        struct next_at_depth_or_next<sentinel<>, Ctx, Sibling, LeftToRight, Up>
+        {
+            using type = typename next_at_depth<Ctx, Sibling, LeftToRight, Up>::type;
+        };
+
+        // PS: sibling, search its subtree first
+        template<typename Ctx, PathStack<Ctx> Stack, bool LeftToRight, size_t Up>
+        requires(has_next_sibling_v<Ctx, Stack, LeftToRight>)
+        struct next_at_depth<Ctx, Stack, LeftToRight, Up>
+        {
+            using sibling = descend_one_t<Ctx, ascend_one_t<Ctx, Stack>, LeftToRight ? top_node_pos_v<Ctx, Stack> + 1 : top_node_pos_v<Ctx, Stack> - 1>;
+            using type    = typename next_at_depth_or_next<typename node_at_depth<Ctx, sibling, Up, LeftToRight>::type, Ctx, sibling, LeftToRight, Up>::type;
+        };
+
+        // PS: root
+        template<typename Ctx, PathStack<Ctx> Stack, bool LeftToRight, size_t Up>
+        requires(stack_size_v<Stack> == 1)
+        struct next_at_depth<Ctx, Stack, LeftToRight, Up>
+        {
+            using type = sentinel<>;
+        };
+
+        template<typename Ctx, PathStack<Ctx> Stack, bool LeftToRight = true>
+        using next_at_depth_t = typename next_at_depth<Ctx, Stack, LeftToRight>::type;
+
+        // the left-most node of the next level once a level is exhausted
+        template<typename Found, typename Ctx, typename Stack>
+        struct next_level_order
+        {
+            using type = Found;
+        };
+
+        template<typename Ctx, typename Stack>
+        struct next_level_order<sentinel<>, Ctx, Stack>
+        {
+            using type = first_at_depth_t<Ctx, root_stack_t<Ctx, stack_root_t<Stack>>, stack_size_v<Stack>>;
+        };
+
+        // the right-most node of the previous level once the first node of a level is passed
+        template<typename Found, typename Ctx, typename Stack>
+        struct prev_level_order
+        {
+            using type = Found;
+        };
+
+        template<typename Ctx, typename Stack>
+        requires(stack_size_v<Stack> > 1)
+        struct prev_level_order<sentinel<>, Ctx, Stack>
+        {
+            using type = last_at_depth_t<Ctx, root_stack_t<Ctx, stack_root_t<Stack>>, stack_size_v<Stack> - 2>;
+        };
+
     }
 
     namespace traversals {
@@ -313,16 +839,16 @@ namespace meta {
         {
             template<typename Ctx, concepts::TreeNode<Ctx> Root>
             struct begin {
-                using type = meta::tlist<Root>;
+                using type = detail::root_stack_t<Ctx, Root>;
             };
 
             template<typename Ctx, concepts::TreeNode<Ctx> Root>
             struct end {
-                using type = detail::descend_deep_right_t<Ctx, meta::tlist<Root>>;
+                using type = detail::descend_deep_right_t<Ctx, detail::root_stack_t<Ctx, Root>>;
             };
 
             // Inner node on top of stack
-            template<typename Ctx, detail::PathStack<Ctx> Stack, concepts::TreeNode<Ctx> Top = type_list::front<Stack>>
+            template<typename Ctx, detail::PathStack<Ctx> Stack, concepts::TreeNode<Ctx> Top = detail::stack_top_t<Ctx, Stack>>
             struct advance {
                 using type = detail::descend_one_t<Ctx, Stack, 0>;
             };
@@ -333,6 +859,28 @@ namespace meta {
             {
                 using type = detail::ascend_next_right_sibling_t<Ctx, Stack>;
             };
+
+            // No left sibling -> parent
+            template<typename Ctx, detail::PathStack<Ctx> Stack>
+            struct retreat {
+                using type = detail::ascend_one_t<Ctx, Stack>;
+            };
+
+            // Left sibling -> its right-most leaf
+            template<typename Ctx, detail::PathStack<Ctx> Stack>
+            requires(detail::has_left_sibling_v<Ctx, Stack>)
+            struct retreat<Ctx, Stack>
+            {
+                using type = detail::descend_deep_right_t<Ctx, detail::descend_one_t<Ctx, detail::ascend_one_t<Ctx, Stack>, detail::top_node_pos_v<Ctx, Stack> - 1>>;
+            };
+
+            // Root
+            template<typename Ctx, detail::PathStack<Ctx> Stack>
+            requires(detail::stack_size_v<Stack> == 1)
+            struct retreat<Ctx, Stack>
+            {
+                using type = sentinel<>;
+            };
         };
 
         template<typename Ctx, typename Stack, template<typename _Ctx, typename _Stack> typename Func>
@@ -355,18 +903,175 @@ namespace meta {
         {
             template<typename Ctx, concepts::TreeNode<Ctx> Root>
             struct begin {
-                using type = detail::descend_deep_left_t<Ctx, meta::tlist<Root>>;
+                using type = detail::descend_deep_left_t<Ctx, detail::root_stack_t<Ctx, Root>>;
             };
 
             template<typename Ctx, concepts::TreeNode<Ctx> Root>
             struct end {
-                using type = detail::descend_deep_right_t<Ctx, meta::tlist<Root>>;
+                using type = detail::descend_deep_right_t<Ctx, detail::root_stack_t<Ctx, Root>>;
             };
 
             template<typename Ctx, detail::PathStack<Ctx> Stack>
             struct advance {
                 using type = apply_if_not_sentinel_t<Ctx, detail::ascend_next_right_sibling_t<Ctx, Stack>, detail::descend_deep_left_t>;
             };
+
+            template<typename Ctx, detail::PathStack<Ctx> Stack>
+            struct retreat {
+                using type = apply_if_not_sentinel_t<Ctx, detail::ascend_next_left_sibling_t<Ctx, Stack>, detail::descend_deep_right_t>;
+            };
+        };
+
+        // Post-order traversal: children left-to-right, then the node itself. The root comes last.
+        struct lrn
+        {
+            template<typename Ctx, concepts::TreeNode<Ctx> Root>
+            struct begin {
+                using type = detail::descend_deep_left_t<Ctx, detail::root_stack_t<Ctx, Root>>;
+            };
+
+            template<typename Ctx, concepts::TreeNode<Ctx> Root>
+            struct end {
+                using type = detail::root_stack_t<Ctx, Root>;
+            };
+
+            // No right sibling -> parent
+            template<typename Ctx, detail::PathStack<Ctx> Stack>
+            struct advance {
+                using type = detail::ascend_one_t<Ctx, Stack>;
+            };
+
+            // Right sibling -> its left-most leaf
+            template<typename Ctx, detail::PathStack<Ctx> Stack>
+            requires(detail::has_right_sibling_v<Ctx, Stack>)
+            struct advance<Ctx, Stack>
+            {
+                using type = detail::descend_deep_left_t<Ctx, detail::descend_one_t<Ctx, detail::ascend_one_t<Ctx, Stack>, detail::top_node_pos_v<Ctx, Stack> + 1>>;
+            };
+
+            // Root
+            template<typename Ctx, detail::PathStack<Ctx> Stack>
+            requires(detail::stack_size_v<Stack> == 1)
+            struct advance<Ctx, Stack>
+            {
+                using type = sentinel<>;
+            };
+
+            // Inner node -> its last child
+            template<typename Ctx, detail::PathStack<Ctx> Stack, concepts::TreeNode<Ctx> Top = detail::stack_top_t<Ctx, Stack>>
+            struct retreat {
+                using type = detail::descend_one_t<Ctx, Stack, node_num_children_v<Ctx, Top> - 1>;
+            };
+
+            // Leaf node -> the closest left sibling of it or an ancestor
+            template<typename Ctx, detail::PathStack<Ctx> Stack, concepts::LeafNode<Ctx> Top>
+            struct retreat<Ctx, Stack, Top>
+            {
+                using type = detail::ascend_next_left_sibling_t<Ctx, Stack>;
+            };
+        };
+
+        // Level-order (breadth-first) traversal: the nodes of each depth left-to-right, depth by depth. Each step searches
+        // the next node of the same depth to the right, after the last one of a depth it starts over from the root one
+        // level deeper.
+        struct level_order
+        {
+            template<typename Ctx, concepts::TreeNode<Ctx> Root>
+            struct begin {
+                using type = detail::root_stack_t<Ctx, Root>;
+            };
+
+            template<typename Ctx, concepts::TreeNode<Ctx> Root>
+            struct end {
+                using type = detail::last_at_depth_t<Ctx, detail::root_stack_t<Ctx, Root>, node_height_v<Ctx, Root>>;
+            };
+
+            template<typename Ctx, detail::PathStack<Ctx> Stack>
+            struct advance {
+                using type = typename detail::next_level_order<detail::next_at_depth_t<Ctx, Stack>, Ctx, Stack>::type;
+            };
+
+            template<typename Ctx, detail::PathStack<Ctx> Stack>
+            struct retreat {
+                using type = typename detail::prev_level_order<detail::next_at_depth_t<Ctx, Stack, false>, Ctx, Stack>::type;
+            };
+        };
+
+        // Pre-order (Base = nlr) or leaf-only (Base = lr) traversal that leaves out whole subtrees. Prune<Ctx, Path>::value
+        // is asked once for every node the traversal reaches, Path being the nodes from the root down to it (like path_t).
+        // If it is true, the node and everything below it is skipped by going on with the next right sibling of it or an
+        // ancestor, without descending. Forward only.
+        template<template<typename, typename> typename Prune, typename Base = nlr>
+        struct pruned
+        {
+            static_assert(std::is_same_v<Base, nlr> || std::is_same_v<Base, lr>, "pruned supports the nlr and lr traversals");
+
+            static constexpr bool leaves_only = std::is_same_v<Base, lr>;
+
+            // the first node to visit at or after Candidate in pre-order, sentinel<> if there is none
+            template<typename Ctx, typename Candidate>
+            struct settle_or_end;
+
+            template<typename Ctx, typename Candidate, bool Skip = Prune<Ctx, detail::stack_path_t<Ctx, Candidate>>::value>
+            struct settle
+            {
+                using type = Candidate;
+            };
+
+            template<typename Ctx, typename Candidate>
+            struct settle<Ctx, Candidate, true>
+            {
+                using type = typename settle_or_end<Ctx, detail::ascend_next_right_sibling_t<Ctx, Candidate>>::type;
+            };
+
+            template<typename Ctx, typename Candidate>
+            requires(leaves_only && concepts::InnerNode<detail::stack_top_t<Ctx, Candidate>, Ctx>)
+            struct settle<Ctx, Candidate, false>
+            {
+                using type = typename settle<Ctx, detail::descend_one_t<Ctx, Candidate, 0>>::type;
+            };
+
+            template<typename Ctx, typename Candidate>
+            struct settle_or_end : settle<Ctx, Candidate>
+            {
+            };
+
+            template<typename Ctx>
+            struct settle_or_end<Ctx, sentinel<>>
+            {
+                using type = sentinel<>;
+            };
+
+            template<typename Ctx, concepts::TreeNode<Ctx> Root>
+            struct begin {
+                using type = typename settle_or_end<Ctx, detail::root_stack_t<Ctx, Root>>::type;
+            };
+
+            template<typename Ctx, detail::PathStack<Ctx> Stack>
+            struct advance {
+                using type = typename settle_or_end<Ctx, typename nlr::template advance<Ctx, Stack>::type>::type;
+            };
+        };
+
+        // The traversal Base backwards, for any Base with retreat (all of the above).
+        template<typename Base>
+        struct reversed
+        {
+            template<typename Ctx, concepts::TreeNode<Ctx> Root>
+            struct begin : Base::template end<Ctx, Root> {};
+
+            template<typename Ctx, concepts::TreeNode<Ctx> Root>
+            struct end : Base::template begin<Ctx, Root> {};
+
+            template<typename Ctx, detail::PathStack<Ctx> Stack>
+            struct advance {
+                using type = typename Base::template retreat<Ctx, Stack>::type;
+            };
+
+            template<typename Ctx, detail::PathStack<Ctx> Stack>
+            struct retreat {
+                using type = typename Base::template advance<Ctx, Stack>::type;
+            };
         };
 
     }
@@ -374,6 +1079,17 @@ namespace meta {
     template<typename Ctx, detail::PathStack<Ctx> Stack, typename Traversal>
     struct tree_iterator;
 
+    //
+    // tree_past_end
+    // What the end sentinel of a traversal wraps: the tree and the traversal, not the last path. Advancing past the last
+    // element yields the same type, so begin/end comparisons never descend to the last element; retreating from it
+    // computes the last element on demand.
+    //
+    template<typename Ctx, typename Root, typename Traversal>
+    struct tree_past_end
+    {
+    };
+
     namespace detail {
         template<typename Ctx, typename OriginalStack, typename NewStackResult, typename Traversal>
         struct tree_advance_switch
@@ -384,7 +1100,19 @@ namespace meta {
         template<typename Ctx, typename OriginalStack, typename Traversal>
         struct tree_advance_switch<Ctx, OriginalStack, sentinel<>, Traversal>
         {
-            using type = sentinel<tree_iterator<Ctx, OriginalStack, Traversal>>;
+            using type = sentinel<tree_past_end<Ctx, stack_root_t<OriginalStack>, Traversal>>;
+        };
+
+        // retreating the first element has no result
+        template<typename Ctx, typename NewStackResult, typename Traversal>
+        struct tree_retreat_switch
+        {
+            using type = tree_iterator<Ctx, NewStackResult, Traversal>;
+        };
+
+        template<typename Ctx, typename Traversal>
+        struct tree_retreat_switch<Ctx, sentinel<>, Traversal>
+        {
         };
     }
 
@@ -394,10 +1122,22 @@ namespace meta {
     template<typename Ctx, detail::PathStack<Ctx> Stack, typename Traversal>
     struct tree_iterator
     {
-        using dereference = type_list::front<Stack>;
+        using dereference = detail::stack_top_t<Ctx, Stack>;
         using advance     = typename detail::tree_advance_switch<Ctx, Stack, typename Traversal::template advance<Ctx, Stack>::type, Traversal>::type;
     };
 
+    template<typename Ctx, typename Stack, typename Traversal>
+    struct retreat<tree_iterator<Ctx, Stack, Traversal>>
+        : detail::tree_retreat_switch<Ctx, typename Traversal::template retreat<Ctx, Stack>::type, Traversal>
+    {
+    };
+
+    template<typename Ctx, typename Root, typename Traversal>
+    struct retreat<sentinel<tree_past_end<Ctx, Root, Traversal>>>
+    {
+        using type = tree_iterator<Ctx, typename Traversal::template end<Ctx, Root>::type, Traversal>;
+    };
+
     template<typename T>
     concept HasType = requires()
     {
@@ -406,24 +1146,25 @@ namespace meta {
 
     //
     // tree_begin
+    // tree_end if the traversal visits no node at all (f.e. a pruned root)
     //
     template<typename Root, typename Ctx = contexts::intrusive, typename Traversal = traversals::nlr>
     requires(concepts::TreeNode<Root, Ctx>)
-    using tree_begin = tree_iterator<Ctx, typename Traversal::template begin<Ctx, Root>::type, Traversal>;
+    using tree_begin = typename detail::tree_advance_switch<Ctx, detail::root_stack_t<Ctx, Root>, typename Traversal::template begin<Ctx, Root>::type, Traversal>::type;
 
     //
     // tree_end
     //
     template<typename Root, typename Ctx = contexts::intrusive, typename Traversal = traversals::nlr>
     requires(concepts::TreeNode<Root, Ctx>)
-    using tree_end = sentinel< tree_iterator<Ctx, typename Traversal::template end<Ctx, Root>::type, Traversal> >;
+    using tree_end = sentinel< tree_past_end<Ctx, Root, Traversal> >;
 
     //
     // tree_enumerator
     //
     template<typename Root, typename Ctx = contexts::intrusive, typename Traversal = traversals::nlr>
     requires(concepts::TreeNode<Root, Ctx>)
-    using tree_enumerator = tree_iterator<Ctx, typename Traversal::template begin<Ctx, Root>::type, Traversal>;
+    using tree_enumerator = tree_begin<Root, Ctx, Traversal>;
 
     //
     // traversal ranges
@@ -440,13 +1181,27 @@ namespace meta {
     template<typename Root, typename Ctx = contexts::intrusive>
     using range_nlr = tree_range_t<Root, Ctx, traversals::nlr>;
 
+    template<typename Root, typename Ctx = contexts::intrusive>
+    using range_lrn = tree_range_t<Root, Ctx, traversals::lrn>;
+
+    template<typename Root, typename Ctx = contexts::intrusive>
+    using range_bfs = tree_range_t<Root, Ctx, traversals::level_order>;
+
+    // the nodes (Base = traversals::lr: the leaves) outside the subtrees pruned by Prune<Ctx, Path>, see traversals::pruned
+    template<typename Root, typename Ctx, template<typename, typename> typename Prune, typename Base = traversals::nlr>
+    using prune_range = tree_range_t<Root, Ctx, traversals::pruned<Prune, Base>>;
+
+    // reverse ranges, f.e. the leaves right-to-left are tree_reverse_range_t<Root, Ctx, traversals::lr>
+    template<typename Root, typename Ctx = contexts::intrusive, typename Traversal = traversals::nlr>
+    using tree_reverse_range_t = tree_range_t<Root, Ctx, traversals::reversed<Traversal>>;
+
     //
     // tree_context
     //
     template<typename Interator>
     struct tree_context;
 
-    template<typename Ctx, concepts::TypeList Stack, typename Traversal>
+    template<typename Ctx, typename Stack, typename Traversal>
     struct tree_context<tree_iterator<Ctx, Stack, Traversal>>
     {
         using type = Ctx;
@@ -455,26 +1210,13 @@ namespace meta {
     template<typename Iterator>
     using tree_context_t = typename tree_context<Iterator>::type;
 
-    namespace detail {
-        template<typename T>
-        struct strip_se
-        {
-            using type = T;
-        };
-
-        template<typename Node, size_t Pos>
-        struct strip_se<SE<Node, Pos>>
-        {
-            using type = Node;
-        };
-    }
 
     //
     // The path of an iterator (ie. all the nodes on the path from the root of the tree up to the current element)
     //
 
-    template<typename Ctx, concepts::TypeList Stack, typename Traversal>
-    type_list::reverse<type_list::transform<Stack, detail::strip_se>> path(tree_iterator<Ctx, Stack, Traversal>);
+    template<typename Ctx, typename Stack, typename Traversal>
+    detail::stack_path_t<Ctx, Stack> path(tree_iterator<Ctx, Stack, Traversal>);
 
     template<typename Iterator>
     using path_t = decltype(path(std::declval<Iterator>()));
@@ -494,6 +1236,145 @@ namespace meta {
     template<concepts::TreeIterator Begin, concepts::TreeIterator End>
     auto path(meta::iterator_range<Begin, End>) -> decltype(path(std::declval<Begin>()));
 
+    //
+    // Runtime visitation of a tree range
+    //
+
+    namespace detail {
+
+        template<typename Ctx, typename Stack>
+        struct node_visit
+        {
+            using node  = stack_top_t<Ctx, Stack>;
+            using depth = std::integral_constant<size_t, stack_size_v<Stack> - 1>;
+            using path  = stack_indices_t<Stack>;
+        };
+
+        // one node_visit per step until End or the end of the traversal
+        template<typename Iterator, typename End, typename Visits>
+        struct range_visit_step
+        {
+            using next = common::detail::iteration_done<Visits>;
+        };
+
+        template<typename Ctx, typename Stack, typename Traversal, typename End, typename... Visits>
+        requires(!std::is_same_v<tree_iterator<Ctx, Stack, Traversal>, End>)
+        struct range_visit_step<tree_iterator<Ctx, Stack, Traversal>, End, meta::tlist<Visits...>>
+        {
+            using next = range_visit_step<advance_t<tree_iterator<Ctx, Stack, Traversal>>, End, meta::tlist<Visits..., node_visit<Ctx, Stack>>>;
+        };
+
+        // the node_visit of every iterator from Begin up to End, for tree ranges only. iterate stops early once the
+        // range is done, so the bound of the steps is a constant rather than the size of the tree, which
+        // node_subtree_size_v computes slowly for wide nodes.
+        static constexpr size_t max_range_visits = size_t(1) << 21;
+
+        template<typename Begin, typename End>
+        struct range_visits;
+
+        template<typename Ctx, typename Stack, typename Traversal, typename End>
+        struct range_visits<tree_iterator<Ctx, Stack, Traversal>, End>
+        {
+            using type = common::detail::iterate_t<range_visit_step<tree_iterator<Ctx, Stack, Traversal>, End, meta::tlist<>>, max_range_visits>;
+        };
+
+        // the range of a traversal that visits no node
+        template<typename Ctx, typename Root, typename Traversal, typename End>
+        struct range_visits<sentinel<tree_past_end<Ctx, Root, Traversal>>, End>
+        {
+            using type = meta::tlist<>;
+        };
+
+        template<typename Begin>
+        struct is_tree_range_begin
+        {
+            static constexpr bool value = false;
+        };
+
+        template<typename Ctx, typename Stack, typename Traversal>
+        struct is_tree_range_begin<tree_iterator<Ctx, Stack, Traversal>>
+        {
+            static constexpr bool value = true;
+        };
+
+        template<typename Ctx, typename Root, typename Traversal>
+        struct is_tree_range_begin<sentinel<tree_past_end<Ctx, Root, Traversal>>>
+        {
+            static constexpr bool value = true;
+        };
+
+        template<typename... Visits, typename F>
+        constexpr void visit_each(meta::tlist<Visits...>, F& f)
+        {
+            (f(std::type_identity<typename Visits::node>{}, typename Visits::depth{}, typename Visits::path{}), ...);
+        }
+
+        template<typename... Visits, typename F>
+        constexpr bool visit_until(meta::tlist<Visits...>, F& f)
+        {
+            return (static_cast<bool>(f(std::type_identity<typename Visits::node>{}, typename Visits::depth{}, typename Visits::path{})) || ...);
+        }
+
+    }
+
+    //
+    // for_each_node( range, f ), for_each_node_until( range, f )
+    // Call f(std::type_identity<Node>{}, std::integral_constant<size_t, Depth>{}, vlist<size_t, Is...>{}) for the nodes of
+    // a tree range in order, the node type, its depth and its index path (see leaf_path_of) all constant expressions. The
+    // nodes are collected once per range, the calls are a single fold expression, f.e.
+    //     for_each_node(range_lr<Root, Ctx>{}, [&](auto node, auto depth, auto path) { ... });
+    // for_each_node_until stops at the first call that returns true and returns whether there was one. Both take the
+    // ranges of tree traversals (see tree_range_t), not ranges adapted from them like filter_range_t.
+    //
+    template<concepts::Range Range, typename F>
+    requires(detail::is_tree_range_begin<begin_t<Range>>::value)
+    constexpr void for_each_node(Range, F&& f)
+    {
+        detail::visit_each(typename detail::range_visits<begin_t<Range>, end_t<Range>>::type{}, f);
+    }
+
+    template<concepts::Range Range, typename F>
+    requires(detail::is_tree_range_begin<begin_t<Range>>::value)
+    constexpr bool for_each_node_until(Range, F&& f)
+    {
+        return detail::visit_until(typename detail::range_visits<begin_t<Range>, end_t<Range>>::type{}, f);
+    }
+
+    //
+    // accumulate over a complete leaf traversal of a nested type list tree
+    // The result is the leaf list of the tree, which flatten computes without advancing through every path stack.
+    //
+
+    namespace detail {
+
+        template<typename Begin, typename End>
+        struct tlist_lr_full_range
+        {
+            static constexpr bool value = false;
+        };
+
+        template<typename Ctx, typename Stack, typename End>
+        requires(std::is_same_v<Ctx, contexts::tlist> || std::is_same_v<Ctx, contexts::indexed<contexts::tlist>>)
+        struct tlist_lr_full_range<tree_iterator<Ctx, Stack, traversals::lr>, End>
+        {
+            using root = stack_root_t<Stack>;
+
+            static constexpr bool value =
+                std::is_same_v<tree_iterator<Ctx, Stack, traversals::lr>, tree_begin<root, Ctx, traversals::lr>> &&
+                std::is_same_v<End, tree_end<root, Ctx, traversals::lr>>;
+        };
+
+    }
+
+    template<concepts::Range Range, typename Fields>
+    requires(detail::tlist_lr_full_range<begin_t<Range>, end_t<Range>>::value)
+    struct accumulate<Range, Fields>
+    {
+        using root = typename detail::tlist_lr_full_range<begin_t<Range>, end_t<Range>>::root;
+
+        using type = type_list::concat<Fields, type_list::flatten<type_list::push_back<type_list::clear<Fields>, root>>>;
+    };
+
 }
 
 #endif
@@ -0,0 +1,192 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef META_TREE_DISPATCH_HPP___
+#define META_TREE_DISPATCH_HPP___
+
+#include <meta/tree_table.hpp>
+#include <meta/dispatch.hpp>
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace meta {
+
+    enum class tree_dispatch_mode
+    {
+        automatic,      // flattened if the tree is small enough, jump tables otherwise
+        jump_tables,    // one table of children per inner node, a lookup per path element
+        flattened       // one table over all paths up to the height of the tree, a single lookup
+    };
+
+    namespace detail {
+
+        // trees whose flattened table has at most this many entries may be dispatched flattened
+        static constexpr size_t tree_dispatch_flat_size = 4096;
+
+        template<typename Id>
+        struct tree_jump
+        {
+            Id first;           // the first child of the node in tree_jump_tables::children
+            Id num_children;
+            Id leaf;            // the leaf index, the number of leaves for inner nodes
+        };
+
+        // the jumps of the children of every inner node in preorder, one table after the other, so every level of a
+        // path is a single load
+        template<typename Id, size_t Size>
+        struct tree_jump_tables
+        {
+            tree_jump<Id>                       root{};
+            std::array<tree_jump<Id>, Size - 1> children{};
+        };
+
+        template<typename Id, typename Table>
+        constexpr tree_jump_tables<Id, Table::size> make_tree_jump_tables()
+        {
+            std::array<tree_jump<Id>, Table::size> jumps{};
+            size_t first = 0;
+            for(size_t i = 0; i < Table::size; ++i) {
+                jumps[i] = { static_cast<Id>(first), static_cast<Id>(Table::num_children[i]), static_cast<Id>(Table::leaf_rank[i]) };
+                first += Table::num_children[i];
+            }
+
+            tree_jump_tables<Id, Table::size> result{};
+            result.root = jumps[0];
+            for(size_t i = 1; i < Table::size; ++i) {
+                result.children[jumps[Table::parent[i]].first + Table::child_index[i]] = jumps[i];
+            }
+            return result;
+        }
+
+        // the paths of a tree as numbers, every index + 1 a digit to the base of the largest number of children + 1
+        template<typename Table>
+        struct tree_path_keys
+        {
+            static constexpr size_t radix  = *std::max_element(Table::num_children.begin(), Table::num_children.end()) + 1;
+            static constexpr size_t height = *std::max_element(Table::depth.begin(), Table::depth.end());
+
+            // radix^height, saturated at tree_dispatch_flat_size + 1
+            static constexpr size_t size = [] {
+                size_t result = 1;
+                for(size_t level = 0; level < height && result <= tree_dispatch_flat_size; ++level) {
+                    result *= radix;
+                }
+                return std::min(result, tree_dispatch_flat_size + 1);
+            }();
+        };
+
+        // the leaf index of every path key, the number of leaves for the keys of inner nodes and of no node
+        template<typename Id, typename Table>
+        constexpr std::array<Id, tree_path_keys<Table>::size> make_tree_flat_table()
+        {
+            std::array<size_t, Table::size> keys{};
+            std::array<Id, tree_path_keys<Table>::size> result{};
+            result.fill(static_cast<Id>(Table::num_leaves));
+            for(size_t i = 1; i < Table::size; ++i) {
+                keys[i] = keys[Table::parent[i]] * tree_path_keys<Table>::radix + Table::child_index[i] + 1;
+            }
+            for(size_t leaf = 0; leaf < Table::num_leaves; ++leaf) {
+                result[keys[Table::leaves[leaf]]] = static_cast<Id>(leaf);
+            }
+            return result;
+        }
+
+        template<typename Root, typename Ctx, typename Table = tree_table<Root, Ctx>>
+        struct tree_dispatcher
+        {
+            using leaves = typename node_leaves<Ctx, Root>::type;
+            using id     = smallest_unsigned_t<Table::size>;
+            using keys   = tree_path_keys<Table>;
+
+            static constexpr bool small = (keys::size <= tree_dispatch_flat_size);
+
+            template<typename Self = tree_dispatcher>
+            static constexpr tree_jump_tables<id, Table::size> jumps = make_tree_jump_tables<typename Self::id, Table>();
+
+            template<typename Self = tree_dispatcher>
+            static constexpr std::array<id, keys::size> flat = make_tree_flat_table<typename Self::id, Table>();
+
+            // the leaf index at path, the number of leaves if it leads to an inner node or past the tree
+            template<tree_dispatch_mode Mode, typename Index, size_t Extent>
+            static constexpr size_t find(std::span<const Index, Extent> path)
+            {
+                if constexpr(Mode == tree_dispatch_mode::flattened || (Mode == tree_dispatch_mode::automatic && small)) {
+                    if(path.size() > keys::height) {
+                        return Table::num_leaves;
+                    }
+                    size_t key = 0;
+                    for(const Index step : path) {
+                        const size_t index = static_cast<size_t>(step);
+                        if(index >= keys::radix - 1) {
+                            return Table::num_leaves;
+                        }
+                        key = key * keys::radix + index + 1;
+                    }
+                    return flat<>[key];
+                } else {
+                    tree_jump<id> jump = jumps<>.root;
+                    for(const Index step : path) {
+                        const size_t index = static_cast<size_t>(step);
+                        if(index >= jump.num_children) {
+                            return Table::num_leaves;
+                        }
+                        jump = jumps<>.children[jump.first + index];
+                    }
+                    return jump.leaf;
+                }
+            }
+        };
+
+    }
+
+    //
+    // tree_dispatch< Root, Ctx, Mode >( path, f, miss )
+    // Runtime dispatch along an index path: calls f.template operator()<Leaf>() for the leaf reached from Root by
+    // taking child path[0], then path[1] and so on, miss() if the path leaves the tree or ends at an inner node. path is
+    // any contiguous range of integers, f.e. a std::span, std::array or std::vector of std::uint8_t. The
+    // result of f must be of the same type for all leaves. The path is resolved to the leaf index (see leaf_index_of)
+    // without recursion, then dispatched like dispatch<Leaves>. Both search structures are built once per tree:
+    //     jump_tables  the children of every inner node in one table each, one lookup per path element
+    //     flattened    the leaf index of every path as a number to the base of the largest number of children + 1,
+    //                  a single lookup; only for trees for which that table is small
+    // f.e. for a message tree addressed by a protocol header
+    //     tree_dispatch<messages>(std::span(header.path, header.depth), [&]<typename Message>() { handle<Message>(buffer); }, [] {});
+    //
+    template<
+        typename Root, typename Ctx = contexts::intrusive, tree_dispatch_mode Mode = tree_dispatch_mode::automatic,
+        std::ranges::contiguous_range Path, typename F, typename Miss
+    >
+    requires(
+        std::ranges::sized_range<Path> && std::integral<std::ranges::range_value_t<Path>> &&
+        (Mode != tree_dispatch_mode::flattened || detail::tree_dispatcher<Root, Ctx>::small)
+    )
+    constexpr typename detail::dispatch_result<typename detail::tree_dispatcher<Root, Ctx>::leaves, std::remove_reference_t<F>>::type
+    tree_dispatch(const Path& path, F&& f, Miss&& miss)
+    {
+        using dispatcher = detail::tree_dispatcher<Root, Ctx>;
+
+        static_assert(
+            std::is_same_v<std::invoke_result_t<Miss&>, typename detail::dispatch_result<typename dispatcher::leaves, std::remove_reference_t<F>>::type>,
+            "tree_dispatch: miss() must return the result type of f"
+        );
+
+        using index = std::ranges::range_value_t<Path>;
+
+        const size_t leaf = dispatcher::template find<Mode>(std::span<const index>(std::ranges::data(path), std::ranges::size(path)));
+        if(leaf < tree_table<Root, Ctx>::num_leaves) {
+            return dispatch<typename dispatcher::leaves>(leaf, f);
+        }
+        return miss();
+    }
+
+}
+
+#endif
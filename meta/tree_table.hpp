@@ -0,0 +1,596 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef META_TREE_TABLE_HPP___
+#define META_TREE_TABLE_HPP___
+
+#include <meta/tree.hpp>
+#include <meta/common.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace meta {
+
+    namespace detail {
+
+        template<typename Ctx, typename Node, typename Children = std::make_index_sequence<node_num_children_v<Ctx, Node>>>
+        struct preorder_nodes;
+
+        template<typename Ctx, typename Node, size_t... Is>
+        struct preorder_nodes<Ctx, Node, std::index_sequence<Is...>>
+        {
+            using type = type_list::concat<meta::tlist<Node>, typename preorder_nodes<Ctx, node_get_child_t<Ctx, Node, Is>>::type...>;
+        };
+
+        template<typename Ctx, concepts::TypeList Nodes>
+        struct preorder_num_children;
+
+        template<typename Ctx, typename... Nodes>
+        struct preorder_num_children<Ctx, meta::tlist<Nodes...>> : common::detail::value_array<size_t, node_num_children_v<Ctx, Nodes>...>
+        {
+        };
+
+        template<size_t Size>
+        struct preorder_layout
+        {
+            std::array<size_t, Size> depth{};
+            std::array<size_t, Size> parent{};
+            std::array<size_t, Size> child_index{};
+            std::array<size_t, Size> subtree_size{};
+        };
+
+        // depth, parent, position in the parent and subtree size of every node, from the number of children in preorder
+        template<size_t Size>
+        constexpr preorder_layout<Size> make_preorder_layout(const std::array<size_t, Size>& num_children)
+        {
+            preorder_layout<Size> layout{};
+            std::array<size_t, Size> open{};    // the inner nodes above the current one
+            std::array<size_t, Size> taken{};   // the number of their children visited so far
+            size_t top = 0;
+            for(size_t i = 0; i < Size; ++i) {
+                layout.depth[i] = top;
+                if(top == 0) {
+                    layout.parent[i] = Size;
+                } else {
+                    layout.parent[i]      = open[top - 1];
+                    layout.child_index[i] = taken[top - 1]++;
+                }
+                if(num_children[i] != 0) {
+                    open[top]  = i;
+                    taken[top] = 0;
+                    ++top;
+                    continue;
+                }
+                layout.subtree_size[i] = 1;
+                while(top != 0 && taken[top - 1] == num_children[open[top - 1]]) {
+                    layout.subtree_size[open[top - 1]] = i + 1 - open[top - 1];
+                    --top;
+                }
+            }
+            return layout;
+        }
+
+        template<size_t NumLeaves, size_t Size>
+        constexpr std::array<size_t, NumLeaves> make_leaves(const std::array<size_t, Size>& num_children)
+        {
+            std::array<size_t, NumLeaves> leaves{};
+            size_t rank = 0;
+            for(size_t i = 0; i < Size; ++i) {
+                if(num_children[i] == 0) {
+                    leaves[rank++] = i;
+                }
+            }
+            return leaves;
+        }
+
+        // rank of every leaf among the leaves, the number of leaves for inner nodes
+        template<size_t Size>
+        constexpr std::array<size_t, Size> make_leaf_ranks(const std::array<size_t, Size>& num_children)
+        {
+            const size_t num_leaves = static_cast<size_t>(std::count(num_children.begin(), num_children.end(), size_t(0)));
+            std::array<size_t, Size> ranks{};
+            size_t rank = 0;
+            for(size_t i = 0; i < Size; ++i) {
+                ranks[i] = (num_children[i] == 0) ? rank++ : num_leaves;
+            }
+            return ranks;
+        }
+
+    }
+
+    //
+    // tree_table< Root, Ctx >
+    // The tree linearized in preorder, computed once per tree: the nodes as a type list and, per preorder index, the
+    // number of children, the depth, the index of the parent (no_parent for the root), the position in the parent and
+    // the size of the subtree. The subtree of node I is [I, I + subtree_size[I]). leaves holds the preorder indices of
+    // the leaves, leaf_rank the inverse (num_leaves for inner nodes).
+    //
+    template<typename Root, typename Ctx = contexts::intrusive>
+    requires(concepts::TreeNode<Root, Ctx>)
+    struct tree_table
+    {
+        using root    = Root;
+        using context = Ctx;
+        using nodes   = typename detail::preorder_nodes<Ctx, Root>::type;
+
+        static constexpr size_t size      = type_list::size<nodes>;
+        static constexpr size_t no_parent = size;
+
+        template<size_t Index>
+        requires(Index < size)
+        using node = type_list::get<nodes, Index>;
+
+        static constexpr const std::array<size_t, size>& num_children = detail::preorder_num_children<Ctx, nodes>::values;
+
+        static constexpr detail::preorder_layout<size> layout = detail::make_preorder_layout(num_children);
+
+        static constexpr const std::array<size_t, size>& depth        = layout.depth;
+        static constexpr const std::array<size_t, size>& parent       = layout.parent;
+        static constexpr const std::array<size_t, size>& child_index  = layout.child_index;
+        static constexpr const std::array<size_t, size>& subtree_size = layout.subtree_size;
+
+        static constexpr size_t num_leaves = static_cast<size_t>(std::count(num_children.begin(), num_children.end(), size_t(0)));
+
+        static constexpr std::array<size_t, num_leaves> leaves    = detail::make_leaves<num_leaves>(num_children);
+        static constexpr std::array<size_t, size>       leaf_rank = detail::make_leaf_ranks(num_children);
+
+        // preorder index of child Pos of node Index
+        static constexpr size_t child(size_t index, size_t pos)
+        {
+            size_t result = index + 1;
+            for(; pos != 0; --pos) {
+                result += subtree_size[result];
+            }
+            return result;
+        }
+    };
+
+    namespace detail {
+
+        // the number of nodes at every depth of a tree_table
+        template<typename Table, size_t Height>
+        constexpr std::array<size_t, Height + 1> make_level_widths()
+        {
+            std::array<size_t, Height + 1> result{};
+            for(const size_t depth : Table::depth) {
+                ++result[depth];
+            }
+            return result;
+        }
+
+    }
+
+    //
+    // tree_stats< Root, Ctx >
+    // The figures to size tables for a tree, read off its tree_table: max_depth (of the deepest node, the root is at 0),
+    // node_count, leaf_count, level_widths (vlist of the number of nodes at every depth) and subtree_sizes (the subtree
+    // size of every node in preorder).
+    //
+    template<typename Root, typename Ctx = contexts::intrusive>
+    requires(concepts::TreeNode<Root, Ctx>)
+    struct tree_stats
+    {
+        using table = tree_table<Root, Ctx>;
+
+        static constexpr size_t max_depth  = *std::max_element(table::depth.begin(), table::depth.end());
+        static constexpr size_t node_count = table::size;
+        static constexpr size_t leaf_count = table::num_leaves;
+
+        static constexpr std::array<size_t, max_depth + 1> level_width_array = detail::make_level_widths<table, max_depth>();
+        static constexpr const std::array<size_t, node_count>& subtree_sizes = table::subtree_size;
+
+        using level_widths = typename common::detail::array_vlist<vlist, level_width_array>::type;
+    };
+
+    namespace detail {
+
+        // table_position< Table, Index >
+        // Path stack of the random access traversals: the preorder index of the current node in a tree_table. The
+        // ancestors are read from the table.
+        template<typename Table, size_t Index>
+        struct table_position
+        {
+        };
+
+        template<typename Table, size_t Index>
+        struct stack_size<table_position<Table, Index>>
+        {
+            static constexpr size_t value = Table::depth[Index] + 1;
+        };
+
+        template<typename Ctx, typename Table, size_t Index>
+        struct stack_top<Ctx, table_position<Table, Index>>
+        {
+            using type = typename Table::template node<Index>;
+        };
+
+        template<typename Ctx, typename Table, size_t Index>
+        struct stack_parent<Ctx, table_position<Table, Index>>
+        {
+            using node = typename Table::template node<Table::parent[Index]>;
+            static constexpr size_t pos = Table::child_index[Index];
+        };
+
+        template<typename Table, size_t Index>
+        struct stack_root<table_position<Table, Index>>
+        {
+            using type = typename Table::root;
+        };
+
+        template<typename Table, size_t Index, size_t Depth = Table::depth[Index]>
+        struct table_path
+        {
+            using type = type_list::push_back<typename table_path<Table, Table::parent[Index]>::type, typename Table::template node<Index>>;
+        };
+
+        template<typename Table, size_t Index>
+        struct table_path<Table, Index, 0>
+        {
+            using type = meta::tlist<typename Table::root>;
+        };
+
+        template<typename Ctx, typename Table, size_t Index>
+        struct stack_path<Ctx, table_position<Table, Index>> : table_path<Table, Index>
+        {
+        };
+
+        template<typename Ctx, typename Table, size_t Index>
+        struct ascend_one<Ctx, table_position<Table, Index>>
+        {
+            using type = table_position<Table, Table::parent[Index]>;
+        };
+
+        template<typename Ctx, typename Table, size_t Index, size_t Pos, concepts::InnerNode<Ctx> Top>
+        struct descend_one<Ctx, table_position<Table, Index>, Pos, Top>
+        {
+            using type = table_position<Table, Table::child(Index, Pos)>;
+        };
+
+        template<typename Table, size_t Index, typename Levels = std::make_index_sequence<Table::depth[Index]>>
+        struct table_indices;
+
+        template<typename Table, size_t Index, size_t... Levels>
+        struct table_indices<Table, Index, std::index_sequence<Levels...>>
+        {
+            static constexpr std::array<size_t, sizeof...(Levels)> indices = [] {
+                std::array<size_t, sizeof...(Levels)> result{};
+                for(size_t node = Index, level = sizeof...(Levels); level != 0; node = Table::parent[node]) {
+                    result[--level] = Table::child_index[node];
+                }
+                return result;
+            }();
+
+            using type = vlist<size_t, indices[Levels]...>;
+        };
+
+        template<typename Table, size_t Index>
+        struct stack_indices<table_position<Table, Index>> : table_indices<Table, Index>
+        {
+        };
+
+        // traversal_order< Table, Base >
+        // the sequence of preorder indices a traversal visits: order(Rank) is the Rank-th node visited, rank(Index) the
+        // inverse for the visited nodes
+        template<typename Table, typename Base>
+        struct traversal_order;
+
+        template<typename Table>
+        struct traversal_order<Table, traversals::nlr>
+        {
+            static constexpr size_t length = Table::size;
+
+            static constexpr size_t order(size_t rank)
+            {
+                return rank;
+            }
+
+            static constexpr size_t rank(size_t index)
+            {
+                return index;
+            }
+        };
+
+        template<typename Table>
+        struct traversal_order<Table, traversals::lr>
+        {
+            static constexpr size_t length = Table::num_leaves;
+
+            static constexpr size_t order(size_t rank)
+            {
+                return Table::leaves[rank];
+            }
+
+            static constexpr size_t rank(size_t index)
+            {
+                return Table::leaf_rank[index];
+            }
+        };
+
+        // advance_position: N steps ahead, sentinel<> one past the last node
+        template<
+            typename Table, typename Base, size_t Index, size_t N,
+            size_t Rank = traversal_order<Table, Base>::rank(Index) + N,
+            bool   End  = (Rank == traversal_order<Table, Base>::length)
+        >
+        requires(Rank <= traversal_order<Table, Base>::length)
+        struct advance_position
+        {
+            using type = table_position<Table, traversal_order<Table, Base>::order(Rank)>;
+        };
+
+        template<typename Table, typename Base, size_t Index, size_t N, size_t Rank>
+        struct advance_position<Table, Base, Index, N, Rank, true>
+        {
+            using type = sentinel<>;
+        };
+
+        // retreat_position: N steps back, sentinel<> before the first node
+        template<typename Table, typename Base, size_t Index, size_t N, size_t Rank = traversal_order<Table, Base>::rank(Index)>
+        struct retreat_position
+        {
+            using type = sentinel<>;
+        };
+
+        template<typename Table, typename Base, size_t Index, size_t N, size_t Rank>
+        requires(Rank >= N)
+        struct retreat_position<Table, Base, Index, N, Rank>
+        {
+            using type = table_position<Table, traversal_order<Table, Base>::order(Rank - N)>;
+        };
+
+        template<typename Table, typename Base>
+        using last_position = table_position<Table, traversal_order<Table, Base>::order(traversal_order<Table, Base>::length - 1)>;
+
+    }
+
+    namespace traversals {
+
+        //
+        // random_access< Base >
+        // The traversal Base (nlr or lr) on the tree_table of the tree. Iterators are a preorder index, so advance_n,
+        // retreat_n, iterator_distance and iterator_less take constant time, f.e. the k-th leaf is
+        //     advance_n_t<tree_begin<Root, Ctx, traversals::random_access<traversals::lr>>, k>
+        // The table is computed once per tree, which pays off as soon as more than a few steps are taken.
+        //
+        template<typename Base>
+        struct random_access
+        {
+            template<typename Ctx, concepts::TreeNode<Ctx> Root>
+            struct begin {
+                using type = detail::table_position<tree_table<Root, Ctx>, detail::traversal_order<tree_table<Root, Ctx>, Base>::order(0)>;
+            };
+
+            template<typename Ctx, concepts::TreeNode<Ctx> Root>
+            struct end {
+                using type = detail::last_position<tree_table<Root, Ctx>, Base>;
+            };
+
+            template<typename Ctx, typename Stack>
+            struct advance;
+
+            template<typename Ctx, typename Table, size_t Index>
+            struct advance<Ctx, detail::table_position<Table, Index>> : detail::advance_position<Table, Base, Index, 1>
+            {
+            };
+
+            template<typename Ctx, typename Stack>
+            struct retreat;
+
+            template<typename Ctx, typename Table, size_t Index>
+            struct retreat<Ctx, detail::table_position<Table, Index>> : detail::retreat_position<Table, Base, Index, 1>
+            {
+            };
+        };
+
+    }
+
+    template<typename Ctx, typename Table, size_t Index, typename Base, size_t N>
+    requires(N > 0)
+    struct advance_n<tree_iterator<Ctx, detail::table_position<Table, Index>, traversals::random_access<Base>>, N>
+    {
+        using type = typename detail::tree_advance_switch<
+            Ctx,
+            detail::table_position<Table, Index>,
+            typename detail::advance_position<Table, Base, Index, N>::type,
+            traversals::random_access<Base>
+        >::type;
+    };
+
+    template<typename Ctx, typename Table, size_t Index, typename Base, size_t N>
+    requires(N > 0)
+    struct retreat_n<tree_iterator<Ctx, detail::table_position<Table, Index>, traversals::random_access<Base>>, N>
+        : detail::tree_retreat_switch<Ctx, typename detail::retreat_position<Table, Base, Index, N>::type, traversals::random_access<Base>>
+    {
+    };
+
+    // from the end sentinel
+    template<typename Ctx, typename Root, typename Base, size_t N>
+    requires(N > 0)
+    struct retreat_n<sentinel<tree_past_end<Ctx, Root, traversals::random_access<Base>>>, N>
+        : retreat_n<retreat_t<sentinel<tree_past_end<Ctx, Root, traversals::random_access<Base>>>>, N - 1>
+    {
+    };
+
+    template<typename Ctx, typename Table, size_t Index, typename Base>
+    struct iterator_position<tree_iterator<Ctx, detail::table_position<Table, Index>, traversals::random_access<Base>>>
+    {
+        static constexpr size_t value = detail::traversal_order<Table, Base>::rank(Index);
+    };
+
+    template<typename Ctx, typename Root, typename Base>
+    struct iterator_position<sentinel<tree_past_end<Ctx, Root, traversals::random_access<Base>>>>
+    {
+        static constexpr size_t value = detail::traversal_order<tree_table<Root, Ctx>, Base>::length;
+    };
+
+    //
+    // flat_node< T, Index >, flat_level_node< T, Index >
+    // One record of a flattened tree (see flatten_tree), indices refer to the same table. The children of a node are
+    // [first_child, first_child + num_children). flat_node is the record of the preorder table, in which the
+    // descendants of record I are (I, subtree_end); flat_level_node that of the level order table, whose subtrees are
+    // not contiguous.
+    //
+    template<typename T, typename Index = size_t>
+    struct flat_node
+    {
+        T     value;
+        Index depth;
+        Index parent;           // the table size for the root
+        Index first_child;      // subtree_end for leaves
+        Index num_children;
+        Index subtree_end;      // one past the last descendant
+
+        friend constexpr bool operator==(const flat_node&, const flat_node&) = default;
+    };
+
+    template<typename T, typename Index = size_t>
+    struct flat_level_node
+    {
+        T     value;
+        Index depth;
+        Index parent;           // the table size for the root
+        Index first_child;      // where the children would start for leaves
+        Index num_children;
+
+        friend constexpr bool operator==(const flat_level_node&, const flat_level_node&) = default;
+    };
+
+    namespace detail {
+
+        // flatten_order< Table, Traversal >
+        // the preorder index of every record of a flattened tree, traversals whose children are adjacent
+        template<typename Table, typename Traversal>
+        struct flatten_order;
+
+        template<typename Table>
+        struct flatten_order<Table, traversals::nlr>
+        {
+            static constexpr std::array<size_t, Table::size> value = [] {
+                std::array<size_t, Table::size> order{};
+                for(size_t i = 0; i < Table::size; ++i) {
+                    order[i] = i;
+                }
+                return order;
+            }();
+        };
+
+        // level by level, each level in preorder
+        template<typename Table>
+        struct flatten_order<Table, traversals::level_order>
+        {
+            static constexpr std::array<size_t, Table::size> value = [] {
+                std::array<size_t, Table::size> order{};
+                size_t pos = 0;
+                for(size_t depth = 0; pos < Table::size; ++depth) {
+                    for(size_t i = 0; i < Table::size; ++i) {
+                        if(Table::depth[i] == depth) {
+                            order[pos++] = i;
+                        }
+                    }
+                }
+                return order;
+            }();
+        };
+
+        // the record of a flattened tree by traversal
+        template<typename Traversal, typename T, typename Index>
+        struct flat_record;
+
+        template<typename T, typename Index>
+        struct flat_record<traversals::nlr, T, Index>
+        {
+            using type = flat_node<T, Index>;
+        };
+
+        template<typename T, typename Index>
+        struct flat_record<traversals::level_order, T, Index>
+        {
+            using type = flat_level_node<T, Index>;
+        };
+
+        template<typename Record, typename Table, typename T, size_t Size>
+        constexpr std::array<Record, Size> make_flat_nodes(const std::array<T, Size>& values, const std::array<size_t, Size>& order)
+        {
+            using index_type = decltype(Record::depth);
+
+            std::array<size_t, Size> rank{};
+            for(size_t r = 0; r < Size; ++r) {
+                rank[order[r]] = r;
+            }
+
+            std::array<Record, Size> result{};
+            size_t next_child = 1;
+            for(size_t r = 0; r < Size; ++r) {
+                const size_t index = order[r];
+                Record& record     = result[r];
+                record.value        = values[index];
+                record.depth        = static_cast<index_type>(Table::depth[index]);
+                record.parent       = static_cast<index_type>((Table::parent[index] == Table::no_parent) ? Size : rank[Table::parent[index]]);
+                record.num_children = static_cast<index_type>(Table::num_children[index]);
+                if constexpr(requires { record.subtree_end; }) {
+                    // preorder, the first child follows the node
+                    record.first_child = static_cast<index_type>(r + 1);
+                    record.subtree_end = static_cast<index_type>(r + Table::subtree_size[index]);
+                } else {
+                    // level order, the children of every level follow each other in the order of their parents
+                    record.first_child = static_cast<index_type>(next_child);
+                    next_child += Table::num_children[index];
+                }
+            }
+            return result;
+        }
+
+        template<typename Table, typename Traversal, template<typename> typename Projection, concepts::TypeList Nodes = typename Table::nodes>
+        struct flat_nodes;
+
+        template<typename Table, typename Traversal, template<typename> typename Projection, typename... Nodes>
+        struct flat_nodes<Table, Traversal, Projection, meta::tlist<Nodes...>>
+        {
+            using value_type = std::remove_cvref_t<decltype(Projection<typename Table::root>::value)>;
+            using index_type = smallest_unsigned_t<sizeof...(Nodes)>;
+            using record     = typename flat_record<Traversal, value_type, index_type>::type;
+
+            static constexpr std::array<record, sizeof...(Nodes)> value = make_flat_nodes<record, Table>(
+                std::array<value_type, sizeof...(Nodes)>{ Projection<Nodes>::value... },
+                flatten_order<Table, Traversal>::value
+            );
+        };
+
+    }
+
+    //
+    // flatten_tree< Root, Ctx, Traversal, Projection >
+    // The tree as a constexpr array of records, one per node in the order of Traversal (traversals::nlr or
+    // traversals::level_order, which both keep the children of a node adjacent), each holding Projection<Node>::value
+    // and the indices of its parent and its children, in the smallest unsigned type that holds the table size. Runtime
+    // code walks it with a loop, f.e.
+    //     for(const auto& node : flatten_tree_v<Root, Ctx, traversals::nlr, id_of>) ...
+    // The preorder records (flat_node) also hold the end of the subtree, the subtree of record I is [I, subtree_end) and
+    // skipping it is a jump to subtree_end. The level order records (flat_level_node) have no such field.
+    //
+    template<typename Root, typename Ctx, typename Traversal, template<typename> typename Projection>
+    requires(concepts::TreeNode<Root, Ctx>)
+    struct flatten_tree
+    {
+        using table      = tree_table<Root, Ctx>;
+        using value_type = typename detail::flat_nodes<table, Traversal, Projection>::value_type;
+        using index_type = typename detail::flat_nodes<table, Traversal, Projection>::index_type;
+        using record     = typename detail::flat_nodes<table, Traversal, Projection>::record;
+
+        static constexpr size_t size      = table::size;
+        static constexpr size_t no_parent = size;
+
+        static constexpr const std::array<record, size>& nodes = detail::flat_nodes<table, Traversal, Projection>::value;
+    };
+
+    template<typename Root, typename Ctx, typename Traversal, template<typename> typename Projection>
+    inline constexpr const auto& flatten_tree_v = flatten_tree<Root, Ctx, Traversal, Projection>::nodes;
+
+}
+
+#endif
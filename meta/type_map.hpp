@@ -0,0 +1,108 @@
+//          Copyright Michael Steinberg 2020
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef META_TYPE_MAP_HPP___
+#define META_TYPE_MAP_HPP___
+
+#include <cstddef>
+#include <type_traits>
+#include <meta/tlist.hpp>
+
+namespace meta {
+
+    namespace detail {
+
+        struct map_miss
+        {
+        };
+
+        template<typename Key, typename Value>
+        struct map_entry
+        {
+            using key   = Key;
+            using value = Value;
+
+            static std::type_identity<Value> lookup(std::type_identity<Key>*);
+        };
+
+        template<typename Pair>
+        struct map_entry_of;
+
+        template<template<typename, typename> typename XPair, typename Key, typename Value>
+        struct map_entry_of<XPair<Key, Value>>
+        {
+            using type = map_entry<Key, Value>;
+        };
+
+        template<typename... Pairs>
+        struct map_entries : map_entry_of<Pairs>::type...
+        {
+            using map_entry_of<Pairs>::type::lookup...;
+
+            static map_miss lookup(const void*);
+        };
+
+        // the mapped type, Default for a missing key
+        template<typename Result, typename Default>
+        struct map_value
+        {
+            static_assert(!std::is_same_v<Result, common::detail::ambiguous_lookup>, "type_map: the key occurs more than once");
+
+            using type = Default;
+        };
+
+        template<typename Value, typename Default>
+        struct map_value<std::type_identity<Value>, Default>
+        {
+            using type = Value;
+        };
+
+        template<typename Entries, typename Key, typename Default>
+        using map_value_t = typename map_value<decltype(common::detail::lookup<Entries, Key>(0)), Default>::type;
+
+    }
+
+    //
+    // type_map< List<Pair<Key, Value>...> >
+    // Compile-time map from key types to value types, f.e. type_map<tlist<std::pair<int, float>>>. Any two parameter
+    // class template can be used as the pair. Like type_list::index_of, a lookup is a single overload resolution
+    // against a set built once per map. Keys must be unique, looking up a key that occurs more than once fails a
+    // static_assert. Checking every key up front would take a lookup per key, which is quadratic for long maps.
+    //
+
+    template<concepts::TypeList Entries>
+    struct type_map;
+
+    template<template<typename...> typename XList, typename... Pairs>
+    struct type_map<XList<Pairs...>>
+    {
+        using entries = XList<Pairs...>;
+        using keys    = XList<typename detail::map_entry_of<Pairs>::type::key...>;
+        using values  = XList<typename detail::map_entry_of<Pairs>::type::value...>;
+
+        static constexpr size_t size = sizeof...(Pairs);
+
+        // at_or< Key, Default >
+        // value of Key, Default if Key is not in the map
+        template<typename Key, typename Default>
+        using at_or = detail::map_value_t<detail::map_entries<Pairs...>, Key, Default>;
+
+        template<typename Key>
+        static constexpr bool contains = !std::is_same_v<at_or<Key, detail::map_miss>, detail::map_miss>;
+
+        template<typename Key>
+        requires(!std::is_same_v<at_or<Key, detail::map_miss>, detail::map_miss>)
+        using at = at_or<Key, detail::map_miss>;
+
+        // value_at< Key >
+        // ::value of the mapped type, for maps to std::integral_constant and the like
+        template<typename Key>
+        requires(!std::is_same_v<at_or<Key, detail::map_miss>, detail::map_miss>)
+        static constexpr auto value_at = at_or<Key, detail::map_miss>::value;
+    };
+
+}
+
+#endif
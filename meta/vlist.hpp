@@ -8,6 +8,7 @@
 
 #include "common.hpp"
 #include <cstddef>
+#include <functional>
 #include <type_traits>
 
 namespace meta
@@ -17,20 +18,22 @@ namespace meta
         template<typename T>
         constexpr bool is_value_list = concepts::ValueList<T>;
 
-        template<concepts::ValueList List>
+        // size, is_empty, front, back, get, to_array and sort also take an avlist, see avlist.hpp
+
+        template<concepts::AnyValueList List>
         constexpr size_t size = common::size_v<List>;
 
-        template<concepts::ValueList List>
-        constexpr bool is_empty = common::is_empty_v<List>;
+        template<concepts::AnyValueList List>
+        constexpr bool is_empty = (size<List> == 0);
 
         template<concepts::ValueList List>
         using clear = common::clear_t<List>;
 
-        template<concepts::ValueList List>
+        template<concepts::AnyValueList List>
         requires(size<List> > 0)
         static constexpr common::value_type_t<List> front = common::front_vlist_v<List>;
 
-        template<concepts::ValueList List>
+        template<concepts::AnyValueList List>
         requires(size<List> > 0)
         static constexpr common::value_type_t<List> back = common::back_vlist_v<List>;
 
@@ -48,8 +51,8 @@ namespace meta
         requires(size<List> > 0)
         using pop_back = common::pop_back_t<List>;
 
-        template<concepts::ValueList List1, concepts::ValueList List2>
-        using concat = common::concat_t<List1, List2>;
+        template<concepts::ValueList List, concepts::ValueList... Lists>
+        using concat = common::concat_t<List, Lists...>;
 
         template<concepts::ValueList List>
         using reverse = common::reverse_t<List>;
@@ -57,14 +60,56 @@ namespace meta
         template<concepts::ValueList List, template< auto Value > class Transformer>
         using transform = common::transform_vlist_t<List, Transformer>;
 
-        template<concepts::ValueList List, size_t N>
+        template<concepts::AnyValueList List, size_t N>
         requires (size<List> > N)
         static constexpr auto get = common::get_vlist_v<List, N>;
 
+        // to_array< List >
+        // the values as a constexpr std::array, one object per distinct sequence of values, see common::to_array_vlist
+        template<concepts::AnyValueList List>
+        constexpr const auto& to_array = common::to_array_vlist_v<List>;
+
         template<concepts::ValueList List, size_t N, common::value_type_t<List> Arg>
         requires (size<List> > N)
         using set = common::set_vlist_t<List, N, Arg>;
 
+        template<concepts::ValueList List, template<auto Value> typename Predicate>
+        using erase_if = common::erase_if_vlist_t<List, Predicate>;
+
+        template<concepts::ValueList List, template<auto Value> typename Predicate>
+        using copy_if = common::copy_if_vlist_t<List, Predicate>;
+
+        // sort< List, Compare >
+        // stable sort, Compare is a constexpr callable that is true if its first argument goes before the second
+        template<concepts::AnyValueList List, typename Compare = std::less<>>
+        using sort = common::sort_vlist_t<List, Compare>;
+
+        // unique< List >
+        // first occurrence of every value, in list order
+        template<concepts::ValueList List>
+        using unique = common::unique_vlist_t<List>;
+
+        // set_union< Lhs, Rhs >
+        // unique< Lhs > followed by the values of Rhs that are not in Lhs
+        template<concepts::ValueList Lhs, concepts::ValueList Rhs>
+        using set_union = common::set_union_vlist_t<Lhs, Rhs>;
+
+        // set_intersection< Lhs, Rhs >
+        // values of unique< Lhs > that are in Rhs
+        template<concepts::ValueList Lhs, concepts::ValueList Rhs>
+        using set_intersection = common::set_intersection_vlist_t<Lhs, Rhs>;
+
+        // set_difference< Lhs, Rhs >
+        // values of unique< Lhs > that are not in Rhs
+        template<concepts::ValueList Lhs, concepts::ValueList Rhs>
+        using set_difference = common::set_difference_vlist_t<Lhs, Rhs>;
+
+        // is_subset< Lhs, Rhs >
+        // every value of Lhs is in Rhs
+        template<concepts::ValueList Lhs, concepts::ValueList Rhs>
+        requires std::is_same_v<common::value_type_t<Lhs>, common::value_type_t<Rhs>>
+        constexpr bool is_subset = common::is_subset_vlist<Lhs, Rhs>::value;
+
         template<concepts::ValueList List, typename Body, size_t Index = 0, size_t Size = size<List>>
         struct for_each_t
         {
@@ -81,27 +126,13 @@ namespace meta
         using for_each = typename for_each_t<List, Body>::type;
     }
 
-    namespace detail {
-
-        template<concepts::ValueList Vlist>
-        struct vlist_front_back_base
-        {
-            static constexpr auto front = value_list::front<Vlist>;
-            static constexpr auto back  = value_list::back<Vlist>;
-
-            using pop_front = value_list::pop_front<Vlist>;
-            using pop_back  = value_list::pop_back<Vlist>;
-        };
-
-        template<template<typename T, T... Vs> typename Vlist, typename T>
-        struct vlist_front_back_base< Vlist<T> >
-        {
-        };
-
-    }
-
+    //
+    // vlist
+    // Like tlist, members that compute something are templates defaulted to the list itself (f.e.
+    // vlist<int, 1, 2>::front<>).
+    //
     template<typename T, T... Vs>
-    struct vlist : public detail::vlist_front_back_base<vlist<T, Vs...>>
+    struct vlist
     {
         static constexpr size_t size = value_list::size<vlist>;
 
@@ -109,20 +140,57 @@ namespace meta
 
         using cleared = value_list::clear<vlist>;
 
+        template<concepts::ValueList Self = vlist>
+        static constexpr T front = value_list::front<Self>;
+
+        template<concepts::ValueList Self = vlist>
+        static constexpr T back = value_list::back<Self>;
+
+        template<concepts::ValueList Self = vlist>
+        using pop_front = value_list::pop_front<Self>;
+
+        template<concepts::ValueList Self = vlist>
+        using pop_back = value_list::pop_back<Self>;
+
         template<T Value>
         using push_front = value_list::push_front<vlist, Value>;
 
         template<T Value>
         using push_back  = value_list::push_back<vlist, Value>;
 
-        using reverse = value_list::reverse<vlist>;
+        template<concepts::ValueList Self = vlist>
+        using reverse = value_list::reverse<Self>;
 
-        template<concepts::ValueList Other>
-        using concat = value_list::concat<vlist, Other>;
+        template<concepts::ValueList... Others>
+        using concat = value_list::concat<vlist, Others...>;
 
         template<template <auto X> typename Transformer>
         using transform = value_list::transform<vlist, Transformer>;
 
+        template<template<auto X> typename Predicate>
+        using erase_if = value_list::erase_if<vlist, Predicate>;
+
+        template<template<auto X> typename Predicate>
+        using copy_if = value_list::copy_if<vlist, Predicate>;
+
+        template<typename Compare = std::less<>>
+        using sort = value_list::sort<vlist, Compare>;
+
+        template<concepts::ValueList Self = vlist>
+        using unique = value_list::unique<Self>;
+
+        template<concepts::ValueList Other>
+        using set_union = value_list::set_union<vlist, Other>;
+
+        template<concepts::ValueList Other>
+        using set_intersection = value_list::set_intersection<vlist, Other>;
+
+        template<concepts::ValueList Other>
+        using set_difference = value_list::set_difference<vlist, Other>;
+
+        template<concepts::ValueList Other>
+        static constexpr bool is_subset = value_list::is_subset<vlist, Other>;
+
         template<template<typename X, X...> typename OtherListType>
         using convert = OtherListType<T, Vs...>;
 
@@ -131,6 +199,9 @@ namespace meta
 
         template<size_t N, common::value_type_t<vlist> Arg>
         using set = value_list::set<vlist, N, Arg>;
+
+        template<concepts::ValueList Self = vlist>
+        static constexpr const auto& to_array = value_list::to_array<Self>;
     };
 
 } // namespace ulib::meta
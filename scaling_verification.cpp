@@ -0,0 +1,2 @@
+
+#include <meta/detail/scaling_verification.hpp>
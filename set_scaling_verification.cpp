@@ -0,0 +1,2 @@
+
+#include <meta/detail/set_scaling_verification.hpp>
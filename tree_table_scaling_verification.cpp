@@ -0,0 +1 @@
+#include <meta/detail/tree_table_scaling_verification.hpp>
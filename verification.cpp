@@ -1,7 +1,7 @@
 
 #include "meta/tree.hpp"
 #include "meta/util.hpp"
-//#include <meta/detail/list_verification.hpp>
+#include <meta/detail/list_verification.hpp>
 #include <meta/detail/tree_verification.hpp>
 
 /*